@@ -128,6 +128,14 @@ public:
     bool    CheckMAMaxSize          ( int32_t lMaxSize                    ///< [in] Maximum length of MA to be tested (MA_MAX_SIZE or MA_REDUCED_SIZE)
                                       );
 
+    /// Check the storage of supervision curves (_CURVE_STORAGE_): the current curve set is computed again
+    /// in double and compared with the stored values
+    /// @return true if the errors are below CURVE_MAX_SPEED_ERROR and CURVE_MAX_DIST_ERROR, otherwise false
+    bool    CheckCurveStorage       (   int32_t &           rlStorage                   , ///< [out] storage used by the EVC (CURVE_STORAGE_DOUBLE, CURVE_STORAGE_FLOAT or CURVE_STORAGE_FIXED)
+                                        t_speed &           rdMaxSpeedError             , ///< [out] maximum error found on speed curves (m/s)
+                                        t_distance &        rdMaxDistError                ///< [out] maximum error found on distance curves (m)
+                                        );
+
     /// Modify the EVC configuration.
     /// It should be call just after constructor
     void    Modify_EVC_Configuration(   bool                bSet                        , ///< [in] indicate if the config should be set or reset
@@ -144,6 +152,23 @@ public:
                                         char *              szFileName                    ///< [in] CSV file name
                                         );
 
+    /// Set parameters of the binary trace used instead of the text logs when CFG_BINARY_TRACE is set
+    /// (decode the file with TraceBin_Decode, see trace_bin.h)
+    /// @return     0 on success, -1 on failure
+    int32_t SetBinaryTraceParameters(   const char *        szFileName                  , ///< [in] binary trace file name
+                                        uint32_t            ulRingSize                  , ///< [in] size of the ring of each module (bytes, power of 2, 0 for default)
+                                        int32_t             lFlushPeriod_ms               ///< [in] period of the flush of the rings to the file (ms)
+                                        );
+
+    /// Set parameters of the recording of module activity in Chrome trace event format (JSON),
+    /// done when CFG_RECORD_CHROME_TRACE is set. The file can be loaded in chrome://tracing or Perfetto:
+    /// one track per module thread, one per external interface.
+    /// @return     0 on success, -1 on failure
+    int32_t SetChromeTraceParameters(   const char *        szFileName                  , ///< [in] JSON file name
+                                        uint32_t            ulCategoryMask              , ///< [in] recorded categories (eChromeTraceCategory bits)
+                                        uint32_t            ulMaxEvents                   ///< [in] maximum number of events kept in memory (oldest are dropped, 0 for no limit)
+                                        );
+
     /// Save the current supervision curves in a CSV formatted file
     /// @return     true on success, false on failure
     bool    SaveCurvesToCSVFile     (   char *                  szCSVFileName           , ///< [in]    file name
@@ -166,7 +191,16 @@ public:
     int32_t Init                    ( uint32_t ulLogId                     ///< [in] key used as prefix for log files
                                       );
 
-    /// Start the EVC simulator modules
+    /// Set the CPU of a module thread in real-time mode (CFG_REALTIME_MODE).
+    /// It should be called before Start_processes.
+    /// @return 0 on success, -1 if the module or the CPU is not valid
+    int32_t SetModuleCpuAffinity    (   eAddressId          ModuleId                    , ///< [in] module (ADDR_EVCCTRL_ID for the EVC controller)
+                                        int32_t             lCpu                          ///< [in] CPU number (RT_NO_CPU for no pinning)
+                                        );
+
+    /// Start the EVC simulator modules.
+    /// With CFG_REALTIME_MODE, the memory is locked and the shared data are prefaulted first,
+    /// then each thread is pinned to its CPU and runs with SCHED_FIFO at RT_FIFO_PRIORITY(lPriority).
     /// @return 0 on success
     int32_t Start_processes         (   void                                            );
 
@@ -182,10 +216,26 @@ public:
     /// @return 0 on success
     int32_t Resume                  (   void                                            );
 
+    /// Advance the simulated time when CFG_STEP_MODE is set (after Run). Each module runs the cycles due in
+    /// the interval, in module order, with the messages sent before the call; Step returns when all these
+    /// cycles are finished. No timer and no sleep are used, so the result does not depend on the host load.
+    /// @return number of module cycles run, -1 if CFG_STEP_MODE is not set or the simulation is not running
+    int32_t Step                    (   int32_t             lDuration_ms                  ///< [in] duration to simulate (ms)
+                                        );
+
     /// Stop the EVC simulation
     /// @return 0 on success
     int32_t Stop                    (   void                                            );
 
+    /// Return a started simulator to its state after Init, to run another scenario without creating
+    /// the threads and communications again: the simulation is stopped, the mailboxes and external
+    /// communications are emptied, the data modified since Init are set to their initial value,
+    /// and the log files and JRU file (CJru_com::ResetFile) are created again.
+    /// Module threads are kept waiting: set the starting conditions then call Run (not Start_processes).
+    /// @return 0 on success, -1 if the simulator is not started (Init and Start_processes must be called first)
+    int32_t Reset                   ( uint32_t ulLogId                     ///< [in] key used as prefix for the new log files
+                                      );
+
 
     /// Get context data
     /// @return true on success
@@ -208,6 +258,66 @@ public:
     /// @return true is communication with DMI is working
     bool    IsDMIReady              (   void                                            );
 
+    /// Get the statistics of the mailbox of a module (one lane per eMsgPriority)
+    /// @return true on success, false if the module has no mailbox
+    bool    GetMailboxStats         (   eAddressId          ModuleId                    , ///< [in]  module owning the mailbox
+                                        SMailboxStats *     pStats                      , ///< [out] statistics of each lane
+                                        bool                bReset = false                ///< [in]  reset the maximum values and counters after reading
+                                        );
+
+    /// Get the cycle statistics of the module threads (modules and EVC controller).
+    /// The statistics are also written in the log file on Stop when CFG_DUMP_CYCLE_STATS is set.
+    /// A reset is only requested (CycleStats_RequestReset): each module clears its own histograms at the top of its next cycle,
+    /// so no sample recorded by a running cycle is lost or torn.
+    /// @return number of modules written in the array
+    int32_t GetModuleCycleStats     (   SModuleCycleStats * aStats                      , ///< [out] statistics of each module
+                                        int32_t             lMaxNb                      , ///< [in]  number of elements of the array
+                                        bool                bReset = false                ///< [in]  request the modules to clear the histograms after reading
+                                        );
+
+    /// Get the latency statistics of the internal messages (queueing and processing time).
+    /// Groups without message are not given.
+    /// @return number of groups written in the array
+    int32_t GetMsgLatencyStats      (   eMsgLatencyGroup    Group                       , ///< [in]  grouping by application code or by sender / receiver pair
+                                        SMsgLatencyStats *  aStats                      , ///< [out] statistics of each group
+                                        int32_t             lMaxNb                      , ///< [in]  number of elements of the array
+                                        bool                bReset = false                ///< [in]  clear the histograms after reading
+                                        );
+
+    /// Get the latency statistics from each external input to the resulting TIU output transitions
+    /// @return number of inputs written in the array
+    int32_t GetInputLatencyStats    (   SInputLatencyStats *aStats                      , ///< [out] statistics of each external input
+                                        int32_t             lMaxNb                      , ///< [in]  number of elements of the array
+                                        bool                bReset = false                ///< [in]  clear the histograms after reading
+                                        );
+
+    /// Set the maximum reaction time of a brake intervention. Each violation is traced, recorded
+    /// in the JRU file and in the CSV file (reaction time columns) when these recordings are active.
+    /// @return 0 on success, -1 if the type is not valid
+    int32_t SetReactionTimeBound    (   eBrakeReaction      Type                        , ///< [in]  monitored intervention
+                                        t_time              dBound                        ///< [in]  maximum reaction time (s, 0 to disable the check)
+                                        );
+
+    /// Get the reaction time statistics of the brake interventions (one element per eBrakeReaction)
+    /// @return number of elements written in the array
+    int32_t GetReactionTimeStats    (   SReactionTimeStats *aStats                      , ///< [out] statistics of each intervention
+                                        int32_t             lMaxNb                      , ///< [in]  number of elements of the array
+                                        bool                bReset = false                ///< [in]  clear the statistics after reading
+                                        );
+
+    /// Get the counters of resources used by the EVC since Init
+    void    GetResourceUsage        (   SResourceUsage *    pUsage                        ///< [out] resource counters
+                                        );
+
+    /// Get the duration of the startup phases (also written in the log file after the first supervision cycle)
+    void    GetStartupTiming        (   SStartupTiming *    pTiming                       ///< [out] duration of each phase
+                                        );
+
+    /// Get the status of the real-time execution: memory locking, scheduling, page faults and deadline misses
+    /// (each page fault or deadline miss of a module thread is also traced)
+    void    GetRealTimeStats        (   SRealTimeStats *    pStats                        ///< [out] real-time status
+                                        );
+
 
     //--------------------------------------------------------------
     //   METHODS TO CONFIFURE EVC SIMULATION (STARTING CONDITIONS)
@@ -672,6 +782,11 @@ public:
     /// test if there is a known target
     bool    IsTargetKnown           (   void                                            );
 
+    /// Get a consistent snapshot of the supervision data (written once per supervision cycle),
+    /// replacing successive calls of the getters above
+    void    GetSupervisionSnapshot  (   SSupervisionSnapshot *  pSnapshot                 ///< [out] copy of the last snapshot
+                                        );
+
     /// Get Staff Responsible maximum speed (km/h)
     double  GetStaffRespSpeed       (   void                                            );
 
@@ -689,6 +804,12 @@ public:
     /// @return session status (RELEASED, INITIALISED, ESTABLISHED, TERMINATED)
     eRadSessionState GetSessionStatus       ( int32_t lEquipmentIdx                      );
 
+    /// Get the status of all radio equipments in one call
+    /// @return number of equipments written in the array
+    int32_t GetRadioStatus          (   SRadioEquipmentStatus * aStatus                 , ///< [out] status of each equipment (index is the equipment ID)
+                                        int32_t                 lMaxNb                    ///< [in]  number of elements of the array
+                                        );
+
     /// Get RBC associated to equipment
     /// @return true if equipment is consistent
     bool GetRadioData( int32_t lEquipmentIdx,
@@ -711,9 +832,28 @@ public:
     /// Get current most restrictive speed (from MRSP) (km/h)
     double  GetMostRestrictiveSpeed (  void                                             );
 
+    /// Get the current supervision curves if they changed since rlCurveCnt.
+    /// Vectors are cleared and filled again: their capacity is kept, so no allocation is done
+    /// when the same structure is reused (use PinCurveSet for access without copy).
     bool    GetSupervisionCurves    (   SInterventionCurves *   pNewCurves              ,
                                         int32_t &                  rlCurveCnt              );
 
+    /// Pin the current supervision curve set without copy: the set is not modified nor reclaimed
+    /// until UnpinCurveSet is called (the curve computation is not blocked meanwhile)
+    /// @return pointer to the curves, NULL if no curve set is available
+    const SIntervCurves *   PinCurveSet (   int32_t &               rlSlot                  , ///< [out] slot of the pinned set (to give to UnpinCurveSet)
+                                            uint32_t &              rulEpoch                  ///< [out] publication epoch of the set
+                                            );
+
+    /// Get the track description of a pinned curve set
+    /// @return pointer to the track description, NULL if the slot is not valid
+    const STrackDesc *      GetPinnedTrackDesc( int32_t             lSlot                     ///< [in] slot returned by PinCurveSet
+                                                );
+
+    /// Release a curve set pinned with PinCurveSet
+    void    UnpinCurveSet           (   int32_t                 lSlot                         ///< [in] slot returned by PinCurveSet
+                                        );
+
     bool    GetGradientProfile      (   SProfile *              pGradProf               ,
                                         int32_t &                  rlCounter               );
 
@@ -726,6 +866,13 @@ public:
     bool    GetMRSP                 (   SProfile *              pMRSP                   ,
                                         int32_t &                  rlCounter               );
 
+    /// Get the MRSP without limitation of the number of discontinuities
+    /// @return true if MRSP is available and has changed (according to counter value),
+    ///         false if not changed or if pMRSP->lCapacity is too small (pMRSP->lNbValues is then set to the needed capacity)
+    bool    GetMRSP                 (   SDynProfile *           pMRSP                   , ///< [in/out] MRSP, arrays and lCapacity provided by caller
+                                        int32_t &                  rlCounter                 ///< [in/out] counter used to test changes
+                                        );
+
     bool    GetDriverAction         (   t_distance &            rdLocation              ,
                                         t_time &                rdTimeStamp             ,
                                         eDriverActionInfo &     rDriverAction           ,
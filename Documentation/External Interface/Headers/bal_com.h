@@ -65,7 +65,8 @@ private:
 
 public:
     /// Constructor to be used when no serial/ethernet communication is used (use methods Send_Balise and Send_Loop)
-    CBalise_com();
+    explicit CBalise_com( eComType ComType = COM_MSG_QUEUE   ///< [in]: COM_SHM_RING to use the shared memory rings (EVC configured with CFG_COM_SHM_RING)
+                          );
 
     /// destructor
     ~CBalise_com( );
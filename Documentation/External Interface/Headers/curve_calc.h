@@ -0,0 +1,193 @@
+/*****************************************************************
+Copyright © 2014 - European Rail Software Applications (ERSA)
+                   5 rue Maurice Blin
+                   67500 HAGUENAU
+                   FRANCE
+                   http://www.ersa-france.com
+
+Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)
+
+Licensed under the EUPL Version 1.1.
+
+You may not use this work except in compliance with the License.
+You may obtain a copy of the License at:
+http://ec.europa.eu/idabc/eupl.html
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+either express or implied. See the License for the specific
+language governing permissions and limitations under the License.
+*****************************************************************/
+
+//*************************************************************************************************
+/// @file   curve_calc.h
+/// @brief  Declaration of the offline calculation of supervision curves.
+/// Project     : EVC Simulator -
+/// Module      : EVC -
+//*************************************************************************************************
+
+#ifndef _CURVE_CALC_H
+#define _CURVE_CALC_H
+
+//-------------------------------------------------------------------------------------------------
+//                                include
+//-------------------------------------------------------------------------------------------------
+#include "EVC_sim.h"
+
+//-------------------------------------------------------------------------------------------------
+//                                define & structure
+//-------------------------------------------------------------------------------------------------
+
+/// Enumeration for result of curve calculation
+typedef enum eCurveCalcResult
+{
+    CURVE_CALC_OK = 0,              ///< Curves computed
+    CURVE_CALC_INVALID_TRAIN_DATA,  ///< Train data or brake models are not consistent
+    CURVE_CALC_INVALID_NATIONAL,    ///< National values are not valid
+    CURVE_CALC_INVALID_TRACK,       ///< Profiles are not sorted or MA is missing
+    CURVE_CALC_TRACK_TOO_LONG,      ///< Track is longer than MAX_LENGTH_METERS
+    CURVE_CALC_CANCELLED            ///< Calculation not done (cancelled by the caller)
+
+} eCurveCalcResult;
+
+#define STR_CURVE_CALC_RESULT(d) \
+   ((d)==CURVE_CALC_OK                  ?   "OK"                    : \
+    (d)==CURVE_CALC_INVALID_TRAIN_DATA  ?   "Invalid train data"    : \
+    (d)==CURVE_CALC_INVALID_NATIONAL    ?   "Invalid national data" : \
+    (d)==CURVE_CALC_INVALID_TRACK       ?   "Invalid track"         : \
+    (d)==CURVE_CALC_TRACK_TOO_LONG      ?   "Track too long"        : \
+    (d)==CURVE_CALC_CANCELLED           ?   "Cancelled"             : "???")
+
+/// Structure containing all the inputs of the curve calculation.
+/// Locations of profiles, TSR and MA are relative to dRefLocation.
+typedef struct SCurveCalcInput
+{
+    STrainCharact   TrainCharact            ;   ///< Train data and brake models (CurrentEBModelParam and CurrentSBModelParam are ignored)
+    int32_t         lEBModelIndex           ;   ///< Index of the EB model to use in TrainCharact.aEBModelParam
+    int32_t         lSBModelIndex           ;   ///< Index of the SB model to use in TrainCharact.aSBModelParam
+    SKn             Kn_p                    ;   ///< Correction factor for positive gradient
+    SKn             Kn_n                    ;   ///< Correction factor for negative gradient
+    int32_t         lAdhesionFactor         ;   ///< Adhesion factor (ADHES_SLIPPERY_RAIL or ADHES_NONSLIPPERY_RAIL)
+    SNationalData   NationalData            ;   ///< National values
+
+    t_distance      dRefLocation            ;   ///< Reference location of the track data
+    SProfile        SSP                     ;   ///< Static speed profile (m/s)
+    SProfile        Gradient                ;   ///< Gradient profile (o/oo)
+    STSRList        TSRList                 ;   ///< Temporary speed restrictions
+    SMA_Para        MA                      ;   ///< Movement authority
+
+} SCurveCalcInput;
+
+/// Bits of the curve masks of SSupervisionSample
+#define SUPERV_CURVE_INDICATION     0x01    ///< Indication curve
+#define SUPERV_CURVE_PERMITTED      0x02    ///< Permitted speed curve
+#define SUPERV_CURVE_WARNING        0x04    ///< Warning curve
+#define SUPERV_CURVE_SBI            0x08    ///< Service brake intervention curve (SBI1 or SBI2)
+#define SUPERV_CURVE_FLOI           0x10    ///< First line of intervention curve
+#define SUPERV_CURVE_EBI            0x20    ///< Emergency brake intervention curve
+
+/// Structure containing one sample of a recorded trajectory
+typedef struct STrajectorySample
+{
+    t_time      dTime       ;   ///< Time of the sample (s)
+    t_distance  dLocation   ;   ///< Location of the train front end (m, same reference as the curves)
+    t_speed     dSpeed      ;   ///< Train speed (m/s)
+
+} STrajectorySample;
+
+/// Structure containing the supervision result of one sample
+typedef struct SSupervisionSample
+{
+    eSpeedMonitoringStatus  SpeedMonitStatus    ;   ///< Speed monitoring (CSM, PIM, TSM or RSM), SPEEDMS_UNKNOWN if out of the curves
+    eInterventionType       Int_Type            ;   ///< Intervention required at this sample
+    uint32_t                uAboveMask          ;   ///< Curves (SUPERV_CURVE_xxx) below the train speed
+    uint32_t                uCrossedMask        ;   ///< Curves (SUPERV_CURVE_xxx) crossed since the previous sample
+
+    t_speed                 dIndicationMargin   ;   ///< Indication speed minus train speed (m/s)
+    t_speed                 dPermittedMargin    ;   ///< Permitted speed minus train speed (m/s)
+    t_speed                 dWarningMargin      ;   ///< Warning speed minus train speed (m/s)
+    t_speed                 dSBIMargin          ;   ///< SBI speed minus train speed (m/s)
+    t_speed                 dFLOIMargin         ;   ///< FLOI speed minus train speed (m/s)
+    t_speed                 dEBIMargin          ;   ///< EBI speed minus train speed (m/s)
+
+} SSupervisionSample;
+
+typedef std::vector<STrajectorySample>  STrajectory;
+typedef std::vector<SSupervisionSample> SSupervisionSampleList;
+
+//--------------------------- class definition -----------------------------
+
+/// Class for calculation of supervision curves without simulator.
+/// No module thread, no shared memory and no odometry are used: the curves are computed
+/// synchronously in the calling thread from the given inputs only.
+/// An instance contains the working buffers of one calculation, so one instance has to be
+/// used per thread, but any number of instances can be used in parallel.
+
+class
+
+#ifdef DLL_EXPORT
+DLL_EXPORT
+#endif
+
+CCurve_calc
+{
+
+public:
+
+    /// Contructor (working buffers are allocated once here)
+    CCurve_calc (void);
+
+    /// Destructor
+    ~CCurve_calc ( );
+
+    /// Initialise the inputs with the default values used by the simulator
+    /// (default train, national values and correction factors, empty track)
+    static void InitInput   (   SCurveCalcInput *       pInput                        ///< [out] inputs to initialise
+                                );
+
+    /// Compute the supervision curves
+    /// @return CURVE_CALC_OK on success, otherwise the error (see eCurveCalcResult)
+    eCurveCalcResult Compute(   const SCurveCalcInput * pInput                      , ///< [in]  train, national and track data
+                                SIntervCurves *         pCurves                     , ///< [out] supervision curves (dRefLocation is the one of the input)
+                                STargetList *           pTargets                    , ///< [out] list of targets (NULL if not needed)
+                                STrackDesc *            pTrack                        ///< [out] MRSP and gradient per meter (NULL if not needed)
+                                );
+
+    /// Compute the supervision curves in the format of CEVC_Sim::GetSupervisionCurves
+    /// @return CURVE_CALC_OK on success, otherwise the error (see eCurveCalcResult)
+    eCurveCalcResult Compute(   const SCurveCalcInput * pInput                      , ///< [in]  train, national and track data
+                                SInterventionCurves *   pCurves                       ///< [out] supervision curves (vectors are cleared before filling)
+                                );
+
+    /// Evaluate the supervision of a recorded trajectory against a curve set (result of Compute
+    /// or CEVC_Sim curves). Samples are processed in order, crossings are given relative to the previous sample.
+    /// @return number of samples located out of the curves
+    static int32_t EvaluateTrajectory(  const SIntervCurves *       pCurves             , ///< [in]  curve set
+                                        const STargetList *         pTargets            , ///< [in]  targets associated to the curve set
+                                        t_speed                     dReleaseSpeed       , ///< [in]  release speed of the MA (m/s)
+                                        const STrajectorySample *   aSamples            , ///< [in]  trajectory samples (increasing time)
+                                        int32_t                     lNbSamples          , ///< [in]  number of samples
+                                        SSupervisionSample *        aResults              ///< [out] result of each sample (lNbSamples elements)
+                                        );
+
+    /// Evaluate the supervision of a recorded trajectory against a curve set
+    /// @return number of samples located out of the curves
+    static int32_t EvaluateTrajectory(  const SIntervCurves *       pCurves             , ///< [in]  curve set
+                                        const STargetList *         pTargets            , ///< [in]  targets associated to the curve set
+                                        t_speed                     dReleaseSpeed       , ///< [in]  release speed of the MA (m/s)
+                                        const STrajectory &         rTrajectory         , ///< [in]  trajectory samples (increasing time)
+                                        SSupervisionSampleList &    rResults              ///< [out] result of each sample (resized to the trajectory size)
+                                        );
+
+    /// Get the last location of the computed curves
+    /// @return index of the last valid point of the curves
+    int32_t GetCurvesEnd    (                                                     );
+
+private:
+
+    void *  m_pWorkData;    ///< Working buffers of the calculation (temporary curves, track description)
+
+};
+
+#endif // _CURVE_CALC_H
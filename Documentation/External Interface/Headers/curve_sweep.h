@@ -0,0 +1,165 @@
+/*****************************************************************
+Copyright © 2014 - European Rail Software Applications (ERSA)
+                   5 rue Maurice Blin
+                   67500 HAGUENAU
+                   FRANCE
+                   http://www.ersa-france.com
+
+Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)
+
+Licensed under the EUPL Version 1.1.
+
+You may not use this work except in compliance with the License.
+You may obtain a copy of the License at:
+http://ec.europa.eu/idabc/eupl.html
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+either express or implied. See the License for the specific
+language governing permissions and limitations under the License.
+*****************************************************************/
+
+//*************************************************************************************************
+/// @file   curve_sweep.h
+/// @brief  Declaration of the parallel evaluation of braking curve variants.
+/// Project     : EVC Simulator -
+/// Module      : EVC -
+//*************************************************************************************************
+
+#ifndef _CURVE_SWEEP_H
+#define _CURVE_SWEEP_H
+
+//-------------------------------------------------------------------------------------------------
+//                                include
+//-------------------------------------------------------------------------------------------------
+#include <vector>
+
+#include "curve_calc.h"
+
+//-------------------------------------------------------------------------------------------------
+//                                define & structure
+//-------------------------------------------------------------------------------------------------
+
+/// Maximum number of values of one axis of the grid
+#define MAX_SWEEP_AXIS_VALUES   32
+
+/// Maximum number of Kn factors in the grid
+#define MAX_SWEEP_KN            8
+
+/// Maximum number of speeds used for the summary of a variant
+#define MAX_SWEEP_SPEEDS        16
+
+/// Structure containing the grid of variants.
+/// Every combination of the axis values is a variant: an empty axis keeps the value of the base input.
+typedef struct SSweepGrid
+{
+    int32_t     lNbTrainCategory                            ;   ///< Number of train categories
+    int32_t     alB3TrainCategory[MAX_SWEEP_AXIS_VALUES]    ;   ///< B3 train categories (see CEVC_Sim::GetB3TrainCategory)
+
+    int32_t     lNbBrakePercentage                          ;   ///< Number of brake percentages
+    int32_t     alBrakePercentage[MAX_SWEEP_AXIS_VALUES]    ;   ///< Brake percentages
+
+    int32_t     lNbKn                                       ;   ///< Number of Kn factors
+    SKn         aKn_p[MAX_SWEEP_KN]                         ;   ///< Correction factors for positive gradient
+    SKn         aKn_n[MAX_SWEEP_KN]                         ;   ///< Correction factors for negative gradient (same index as aKn_p)
+
+    int32_t     lNbAdhesion                                 ;   ///< Number of adhesion factors
+    int32_t     alAdhesionFactor[MAX_SWEEP_AXIS_VALUES]     ;   ///< Adhesion factors (in %)
+
+    int32_t     lNbGradientOffset                           ;   ///< Number of gradient offsets
+    double      adGradientOffset[MAX_SWEEP_AXIS_VALUES]     ;   ///< Offsets added to the whole gradient profile (o/oo)
+
+    int32_t     lNbReleaseSpeed                             ;   ///< Number of release speeds
+    t_speed     adReleaseSpeed[MAX_SWEEP_AXIS_VALUES]       ;   ///< Release speeds (m/s)
+
+    int32_t     lNbSpeed                                    ;   ///< Number of speeds used for the summaries
+    t_speed     adSpeed[MAX_SWEEP_SPEEDS]                   ;   ///< Speeds at which distances and times are given (m/s)
+
+} SSweepGrid;
+
+/// Structure containing the parameters of one variant
+typedef struct SSweepVariant
+{
+    int32_t     lB3TrainCategory    ;   ///< B3 train category
+    int32_t     lBrakePercentage    ;   ///< Brake percentage
+    int32_t     lKnIndex            ;   ///< Index of the Kn factors in the grid (-1 for the base input)
+    int32_t     lAdhesionFactor     ;   ///< Adhesion factor (in %)
+    double      dGradientOffset     ;   ///< Offset added to the gradient profile (o/oo)
+    t_speed     dReleaseSpeed       ;   ///< Release speed (m/s)
+
+} SSweepVariant;
+
+/// Structure containing the summary of one variant (arrays are indexed as SSweepGrid::adSpeed)
+typedef struct SSweepSummary
+{
+    SSweepVariant       Variant                             ;   ///< Parameters of the variant
+    eCurveCalcResult    Result                              ;   ///< Result of the curve calculation
+
+    t_distance          adEBIDistance[MAX_SWEEP_SPEEDS]     ;   ///< Distance to the target from the EBI point at the speed (m)
+    t_distance          adPermittedDistance[MAX_SWEEP_SPEEDS];  ///< Distance to the target from the permitted point at the speed (m)
+    t_time              adBrakingTime[MAX_SWEEP_SPEEDS]     ;   ///< Time to reach the target speed when braking from the permitted point (s)
+    t_distance          dEBIEndLocation                     ;   ///< Location where the EBI curve reaches the release speed (m)
+
+} SSweepSummary;
+
+/// List of summaries (one per variant, in the order of the grid)
+typedef std::vector<SSweepSummary> SSweepSummaryList;
+
+//--------------------------- class definition -----------------------------
+
+/// Class for evaluation of a grid of braking curve variants against one track description.
+/// The variants are shared out between worker threads (one CCurve_calc per thread): each thread
+/// processes its own queue of variants and steals from the other queues when its queue is empty,
+/// so slow variants (long tracks, low braking) do not leave the other threads idle.
+/// The worker threads are created by the constructor and reused by each call to Run.
+
+class
+
+#ifdef DLL_EXPORT
+DLL_EXPORT
+#endif
+
+CCurve_sweep
+{
+
+public:
+
+    /// Contructor
+    CCurve_sweep (  int32_t lNbThreads = 0  ///< [in] number of worker threads (0 for the number of CPUs)
+                    );
+
+    /// Destructor (worker threads are stopped)
+    ~CCurve_sweep ( );
+
+    /// Get the number of variants of a grid
+    /// @return number of variants
+    static int32_t GetVariantNb (   const SSweepGrid *      pGrid                         ///< [in] grid of variants
+                                    );
+
+    /// Evaluate all the variants of the grid (blocking call)
+    /// @return number of variants for which the curve calculation failed (see SSweepSummary::Result)
+    int32_t Run             (   const SCurveCalcInput * pBaseInput                  , ///< [in]  base inputs (train, national and track data)
+                                const SSweepGrid *      pGrid                       , ///< [in]  grid of variants
+                                SSweepSummaryList &     rSummaries                    ///< [out] summary of each variant
+                                );
+
+    /// Stop the current evaluation (called from another thread): Run returns once the variants
+    /// in progress are finished, the other summaries are set with CURVE_CALC_CANCELLED
+    void    Cancel          (                                                     );
+
+    /// Get the progress of the current evaluation
+    /// @return number of variants already evaluated
+    int32_t GetProgress     (                                                     );
+
+    /// Get the number of worker threads
+    /// @return number of threads
+    int32_t GetThreadNb     (                                                     );
+
+private:
+
+    void *  m_pPool;    ///< Worker threads and their queues
+
+};
+
+#endif // _CURVE_SWEEP_H
@@ -45,6 +45,8 @@ class CSerial;
 #define DMI_BUFFER_SIZE                 2048    ///< DMI message buffer size
 #define DMI_COM_PROTOCOL_MAJOR_CODE     4       ///< DMI communication major version number
 #define DMI_COM_PROTOCOL_MINOR_CODE     3       ///< DMI communication minor version number
+#define DMI_MAX_ICONS                   64      ///< Number of icons reserved at construction (more icons are stored, with an allocation)
+#define DMI_MAX_TEXT_MSG                64      ///< Number of text messages reserved at construction (more messages are stored, with an allocation)
 
 typedef struct SDmiComTextMsg
 {
@@ -164,7 +166,8 @@ CDMI_com : public CBridge
 public:
 
     /// Constructor to be used when no DMI communication is used (or simplified DMI)
-    CDMI_com();
+    explicit CDMI_com( eComType ComType = COM_MSG_QUEUE  ///< [in]: COM_SHM_RING to use the shared memory rings (EVC configured with CFG_COM_SHM_RING)
+                       );
 
     /// Constructor to be used when DMI named pipe communication is used
     CDMI_com(   const char* szInPipe,   ///< [in]: Pipe in (DMI --> EVC)
@@ -257,9 +260,23 @@ public:
     /// get list of displayed icons
     void getIconList ( std::vector<SDmiComIcon> & icons ) const;
 
+    /// get list of displayed icons without allocation (for cyclic calls).
+    /// At most lMaxNb icons are copied, the next ones are not returned.
+    /// @return number of icons copied in the array
+    int32_t getIconList ( SDmiComIcon * aIcons,         ///< [out] displayed icons
+                          int32_t lMaxNb                ///< [in]  number of elements of the array (DMI_MAX_ICONS)
+                          ) const;
+
     /// get list of displayed text messages
     void getTextMessageList( std::vector<SDmiComTextMsg> & texts );
 
+    /// get list of displayed text messages without allocation (for cyclic calls).
+    /// At most lMaxNb messages are copied, the next ones are not returned.
+    /// @return number of messages copied in the array
+    int32_t getTextMessageList( SDmiComTextMsg * aTexts,    ///< [out] displayed text messages
+                                int32_t lMaxNb              ///< [in]  number of elements of the array (DMI_MAX_TEXT_MSG)
+                                );
+
     /// get list of active levels
     void getLevelList( std::vector<SLevel> & levels );
 
@@ -398,8 +415,9 @@ private:
 
     uint32_t m_ulMenuMask;
     uint32_t m_ulEvcRequest;
-    std::vector<SDmiComTextMsg> m_messages;
-    std::vector<SDmiComIcon> m_icons;
+    // Capacity reserved at construction: going beyond allocates once, the larger capacity is then kept
+    std::vector<SDmiComTextMsg> m_messages;     // capacity DMI_MAX_TEXT_MSG
+    std::vector<SDmiComIcon> m_icons;           // capacity DMI_MAX_ICONS
     std::vector<SLevel> m_levels;
     SDmiComDynamic m_Dynamic;
     bool m_bCabinOpen;
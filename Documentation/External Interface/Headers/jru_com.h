@@ -58,7 +58,8 @@ private:
 
 public:
     /// Default constructor: a file to store JRU data is created
-    CJru_com();
+    explicit CJru_com( eComType ComType = COM_MSG_QUEUE  ///< [in]: COM_SHM_RING to use the shared memory rings (EVC configured with CFG_COM_SHM_RING)
+                       );
 
     /// destructor
     ~CJru_com();
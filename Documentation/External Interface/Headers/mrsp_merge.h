@@ -0,0 +1,113 @@
+/*****************************************************************
+Copyright © 2014 - European Rail Software Applications (ERSA)
+                   5 rue Maurice Blin
+                   67500 HAGUENAU
+                   FRANCE
+                   http://www.ersa-france.com
+
+Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)
+
+Licensed under the EUPL Version 1.1.
+
+You may not use this work except in compliance with the License.
+You may obtain a copy of the License at:
+http://ec.europa.eu/idabc/eupl.html
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+either express or implied. See the License for the specific
+language governing permissions and limitations under the License.
+*****************************************************************/
+
+//*************************************************************************************************
+/// @file   mrsp_merge.h
+/// @brief  Declaration of the streaming merge of speed profiles into the MRSP.
+/// Project     : EVC Simulator -
+/// Module      : EVC -
+//*************************************************************************************************
+
+#ifndef _MRSP_MERGE_H
+#define _MRSP_MERGE_H
+
+//-------------------------------------------------------------------------------------------------
+//                                include
+//-------------------------------------------------------------------------------------------------
+#include "etcs_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//                                define & structure
+//-------------------------------------------------------------------------------------------------
+
+/// Minimum size of the memory given to MRSP_Init (bytes)
+#define MRSP_MIN_ARENA_SIZE     ( (PROF_SRC_NB + 1) * MAX_PROFILE_DISCONTINUITIES * (sizeof(t_distance) + sizeof(double)) )
+
+/// Structure containing the state of the MRSP merge.
+/// Each source is a step profile sorted by location (value valid from adDistance[i] up to adDistance[i+1]).
+/// The merge walks all sources at once (one cursor per source) and only emits a discontinuity
+/// when the minimum value changes, so the MRSP is built in one pass without intermediate profiles.
+typedef struct SMRSPMerge
+{
+    SProfileArena   Arena                   ;   ///< Memory used for the sources and the MRSP
+    SDynProfile     aSource[PROF_SRC_NB]    ;   ///< Current profile of each source
+    SDynProfile     MRSP                    ;   ///< Result of the last merge
+    uint32_t        ulChangedSources        ;   ///< Bit (1 << eProfileSource) set when the source changed since last merge
+    t_distance      dFirstChangeLoc         ;   ///< First location affected by the changes since last merge
+    int32_t         lCount                  ;   ///< Counter incremented each time a new MRSP is available
+
+} SMRSPMerge;
+
+//-------------------------------------------------------------------------------------------------
+//                                function prototype
+//-------------------------------------------------------------------------------------------------
+
+/// Initialise the merge in the given memory (no allocation is done afterwards)
+/// @return true on success, false if ulMemorySize is lower than MRSP_MIN_ARENA_SIZE
+bool MRSP_Init( SMRSPMerge *    pMerge          ,   ///< [out] merge to initialise
+                void *          pMemory         ,   ///< [in]  memory used as arena
+                size_t          ulMemorySize        ///< [in]  size of the memory in bytes
+                );
+
+/// Remove all sources and the MRSP (the arena is emptied)
+void MRSP_Reset( SMRSPMerge * pMerge        ///< [in/out] merge to reset
+                 );
+
+/// Replace the profile of one source. Other sources are kept untouched.
+/// The arena is compacted if there is no more free space for the new profile.
+/// @return true on success, false if the arena is too small or if the locations are not sorted
+bool MRSP_SetSource( SMRSPMerge *       pMerge      ,   ///< [in/out] merge
+                     eProfileSource     Source      ,   ///< [in] source to replace
+                     const t_distance * adDistance  ,   ///< [in] array of locations (increasing order)
+                     const double *     adValue     ,   ///< [in] array of speed values (m/s)
+                     int32_t            lNbValues   ,   ///< [in] number of discontinuities (0 to remove the source)
+                     bool               bInfinite       ///< [in] indicate if the profile is not distance limited
+                     );
+
+/// Replace the profile of one source from a fixed size profile
+/// @return true on success
+bool MRSP_SetSourceProfile( SMRSPMerge *        pMerge      ,   ///< [in/out] merge
+                            eProfileSource      Source      ,   ///< [in] source to replace
+                            const SProfile *    pProfile        ///< [in] new profile of the source
+                            );
+
+/// Merge the sources into the MRSP. Only the part located after dFirstChangeLoc is merged again,
+/// the MRSP discontinuities located before are kept.
+/// @return true if the MRSP has been modified
+bool MRSP_Merge( SMRSPMerge * pMerge        ///< [in/out] merge
+                 );
+
+/// Copy the MRSP in a fixed size profile (used for DMI and existing interfaces)
+/// @return true on success, false if the MRSP has more than MAX_PROFILE_DISCONTINUITIES points (profile is truncated)
+bool MRSP_ToProfile( const SMRSPMerge * pMerge      ,   ///< [in]  merge
+                     SProfile *         pProfile        ///< [out] fixed size profile
+                     );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // _MRSP_MERGE_H
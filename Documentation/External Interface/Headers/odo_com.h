@@ -102,7 +102,8 @@ COdo_com
 {
 public:
     /// constructor
-    COdo_com();
+    explicit COdo_com( eComType ComType = COM_MSG_QUEUE  ///< [in]: COM_SHM_RING to use the shared memory rings (EVC configured with CFG_COM_SHM_RING)
+                       );
 
     /// destructor
     ~COdo_com();
@@ -150,6 +151,30 @@ public:
     /// @return EVC TIU
     STxTiuData getEvcTiu() const { return m_EvcTIU;      }
 
+    //////////// TIU events from EVC //////////////
+
+    /// Register a function called on each TIU output transition. The function is called in the thread
+    /// of the train interface manager as soon as the transition is published: it must be short and non blocking.
+    /// Events are still queued for ReadTiuEvent when a function is registered.
+    void SetTiuEventCallback    ( t_TiuEventCallback   pCallback,                  ///< [in] function to call (NULL to unregister)
+                                  void *               pContext                    ///< [in] user pointer given to the function
+                                  );
+
+    /// Get the file descriptor readable when TIU output events are pending.
+    /// The descriptor is only to be watched (poll/select or an event loop), never read by the client:
+    /// it is reset by ReadTiuEvent when the last pending event has been read.
+    /// @return file descriptor, -1 on error
+    int32_t GetTiuEventFd       ( void );
+
+    /// Read the next pending TIU output event (getEvcTiu is updated with the event data).
+    /// When more than TIU_EVENT_QUEUE_SIZE events are pending, the oldest ones are lost (see STxTiuEvent::ulSequence).
+    /// Call it until it returns 0: the event descriptor (GetTiuEventFd) is then reset.
+    /// @return -1 on error
+    /// @return  0 when there is no pending event (event descriptor reset)
+    /// @return  1 when an event has been read
+    int32_t ReadTiuEvent        ( STxTiuEvent *        pEvent                      ///< [out] TIU output transition
+                                  );
+
 
     //////////// Get TIU from EVC //////////////
 
@@ -265,6 +290,14 @@ public:
                        bool            bTractionOn,                ///< [in] indicate if the traction is set
                        bool            bSystFailure );             ///< [in] indicate if there is a system failure
 
+    /// Send the changed fields of the train TIU to EVC in one message.
+    /// The train interface manager applies all the fields of the mask in the same cycle, so no intermediate
+    /// state is seen by EVC. Fields out of the mask keep their last value (see getTrainTiu).
+    /// @return 0 on success
+    int32_t SetTiuDataDelta     ( const SRxTiuData *   pData,                      ///< [in] train TIU (only the fields of the mask are used)
+                                  uint32_t             ulChangedMask               ///< [in] fields to apply (RX_TIU_xxx, RX_TIU_ALL for the whole structure)
+                                  );
+
     /// Set indication if ETCS power is on
     /// @return 0 on success
     int32_t SetMainSwitchOn            ( bool bValue );
@@ -370,6 +403,12 @@ private:
     SComParam   m_Odo_Com;
     SComParam   m_TIU_Com;
 
+    // notification of TIU output transitions
+    int32_t             m_lTiuEventFd;
+    uint32_t            m_ulTiuEventSeq;
+    t_TiuEventCallback  m_pTiuEventCallback;
+    void *              m_pTiuEventContext;
+
     /// Initialise TIU data
     void Init( void );
 };
@@ -36,6 +36,14 @@ language governing permissions and limitations under the License.
 //------------------------------ include ---------------------------------------
 #include "etcs_types.h"
 
+//------------------------------ define ----------------------------------------
+
+/// Equipment ID used to receive a message from any radio equipment
+#define RAD_ANY_EQUIPMENT   (-1)
+
+/// Timeout value to wait without time limit
+#define RAD_WAIT_INFINITE   (-1)
+
 //--------------------------- class definition -----------------------------
 
 /// class used for the management of radio communication with EVC
@@ -52,12 +60,16 @@ private:
     bool    m_bInit_ok;
     bool    m_bUseDirectCom;
 
-    SComParam    m_Rad_Com;
-    SComParam    m_Rad_Com2;
+    int32_t      m_lNbEquipment;
+    SComParam    m_aRad_Com[MAX_RADIO_EQUIPMENT];
+
+    int32_t      m_lRxEventFd;
 
 public:
     /// Constructor to be used when no ethernet radio communication is used (use methods Send_Radio_Msg and Receive_Radio_Msg)
-    CRadio_com( );
+    CRadio_com( int32_t  lNbEquipment = 2,              ///< [in]: number of radio equipments (2 to MAX_RADIO_EQUIPMENT), each with its own queue
+                eComType ComType = COM_MSG_QUEUE     ///< [in]: COM_SHM_RING to use the shared memory rings (EVC configured with CFG_COM_SHM_RING)
+                );
 
     /// Destructor
     ~CRadio_com( );
@@ -66,20 +78,24 @@ public:
     /// @return: class size in bytes
     int32_t Get_Class_Size      ();
 
+    /// Get the number of radio equipments
+    /// @return: number of equipments (IDs are 0 to number - 1)
+    int32_t GetEquipmentNb      ();
+
     /// Send a radio message to EVC via the indicated radio equipment
     /// @return: 0 if message is sent correctly
     int32_t Send_Radio_Msg      ( int32_t iMsgLength,     ///< [in]: Message length in bytes
                                   uint8_t *  uszMsg,         ///< [in]: Message (binary stream)
-                                  int32_t iEquipmentID   ///< [in]: radio equipement ID (0 or 1)
+                                  int32_t iEquipmentID   ///< [in]: radio equipement ID (0 to GetEquipmentNb() - 1)
                                   );
 
-    /// Send a radio message to EVC via the first radio equipment
+    /// Send a radio message to EVC via the first radio equipment (same as Send_Radio_Msg with equipment 0)
     /// @return: 0 if message is sent correctly
     int32_t Send_Radio_Msg1     ( int32_t iMsgLength,     ///< [in]: Message length in bytes
                                   uint8_t *  uszMsg          ///< [in]: Message (binary stream)
                                   );
 
-    /// Send a radio message to EVC via the second radio equipment
+    /// Send a radio message to EVC via the second radio equipment (same as Send_Radio_Msg with equipment 1)
     /// @return: 0 if message is sent correctly
     int32_t Send_Radio_Msg2     ( int32_t iMsgLength,     ///< [in]: Message length in bytes
                                   uint8_t *  uszMsg          ///< [in]: Message (binary stream)
@@ -90,22 +106,55 @@ public:
     int32_t Receive_Radio_Msg   ( uint8_t *         uszMsg,         ///< [out] : pointer on the buffer to store the received data
                                   int32_t           iMaxLength,     ///< [in]  : maximum size of the buffer to store the received data
                                   bool              bWait,          ///< [in]  : (DEPRECATED)qualificator indicating if the function should block until data are received
-                                  int32_t           iEquipmentID   ///< [in]  : equipment ID ( 0 or 1)
+                                  int32_t           iEquipmentID   ///< [in]  : equipment ID (0 to GetEquipmentNb() - 1)
                                   );
 
-    /// Receive a radio message from the first EVC radio equipement
+    /// Receive a radio message from the first EVC radio equipement (same as Receive_Radio_Msg with equipment 0)
     /// @return Size of the received message in bytes (0 if there is no message)
     int32_t Receive_Radio_Msg1  ( uint8_t *        uszMsg,         ///< [out] : pointer on the buffer to store the received data
                                   int32_t          iMaxLength,     ///< [in]  : maximum size of the buffer to store the received data
                                   bool             bWait           ///< [in]  : (DEPRECATED)qualificator indicating if the function should block until data are received
                                   );
 
-    /// Receive a radio message from the second EVC radio equipement
+    /// Receive a radio message from the second EVC radio equipement (same as Receive_Radio_Msg with equipment 1)
     /// @return Size of the received message in bytes (0 if there is no message)
     int32_t Receive_Radio_Msg2  ( uint8_t *        uszMsg,         ///< [out] : pointer on the buffer to store the received data
                                   int32_t          iMaxLength,     ///< [in]  : maximum size of the buffer to store the received data
                                   bool             bWait           ///< [in]  : (DEPRECATED)qualificator indicating if the function should block until data are received
                                   );
+
+    /// Receive a radio message, blocking until a message is received or the timeout elapses
+    /// @return Size of the received message in bytes (0 if there is no message at timeout, -1 on error)
+    int32_t Receive_Radio_Msg_Wait( uint8_t *      uszMsg,         ///< [out] : pointer on the buffer to store the received data
+                                  int32_t          iMaxLength,     ///< [in]  : maximum size of the buffer to store the received data
+                                  int32_t          iTimeoutMs,     ///< [in]  : maximum waiting time in ms (0: no wait, RAD_WAIT_INFINITE: no limit)
+                                  int32_t          iEquipmentID,   ///< [in]  : equipment ID (0 to GetEquipmentNb() - 1 or RAD_ANY_EQUIPMENT)
+                                  int32_t *        piRxEquipmentID ///< [out] : equipment ID of the received message (can be NULL)
+                                  );
+
+    /// Get the event file descriptor (eventfd) readable when a message is available on any radio equipment.
+    /// It can be used in select/poll/epoll: after it is readable, read it (8 bytes) to clear the event,
+    /// then call Receive_Radio_Msg (or Receive_Radio_Msg_Wait with no wait) until it returns 0.
+    /// @return file descriptor (owned by the class), -1 if not available
+    int32_t GetRxEventFd        ();
+
+    /// Receive all the pending radio messages of the indicated equipment(s) in one call.
+    /// Messages are copied one after the other in the arena, the descriptors give their location.
+    /// Messages which do not fit in the arena or in the descriptor array are kept for the next call.
+    /// @return Number of received messages (0 if there is no message, -1 on error)
+    int32_t Receive_Radio_Msgs  ( uint8_t *        uszArena,       ///< [out] : buffer to store the data of the received messages
+                                  int32_t          iArenaSize,     ///< [in]  : size of the buffer in bytes
+                                  SRadioMsgDesc *  pDesc,          ///< [out] : array of message descriptors
+                                  int32_t          iMaxMsgNb,      ///< [in]  : number of elements of the descriptor array
+                                  int32_t          iEquipmentID    ///< [in]  : equipment ID (0 to GetEquipmentNb() - 1 or RAD_ANY_EQUIPMENT)
+                                  );
+
+    /// Send several radio messages to EVC in one call (each message is sent via the equipment of its descriptor)
+    /// @return Number of messages sent (messages are sent in order, stops at first error)
+    int32_t Send_Radio_Msgs     ( const uint8_t *       uszArena,  ///< [in]  : buffer containing the data of the messages
+                                  const SRadioMsgDesc * pDesc,     ///< [in]  : array of message descriptors (dTimeStamp is ignored)
+                                  int32_t               iMsgNb     ///< [in]  : number of messages
+                                  );
 };
 
 #endif
@@ -0,0 +1,169 @@
+/*****************************************************************
+Copyright © 2014 - European Rail Software Applications (ERSA)
+                   5 rue Maurice Blin
+                   67500 HAGUENAU
+                   FRANCE
+                   http://www.ersa-france.com
+
+Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)
+
+Licensed under the EUPL Version 1.1.
+
+You may not use this work except in compliance with the License.
+You may obtain a copy of the License at:
+http://ec.europa.eu/idabc/eupl.html
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+either express or implied. See the License for the specific
+language governing permissions and limitations under the License.
+*****************************************************************/
+
+//*************************************************************************************************
+/// @file   trace_bin.h
+/// @brief  Declaration of the binary trace of the modules (used instead of text logs with CFG_BINARY_TRACE).
+/// Project     : EVC Simulator -
+/// Module      : EVC -
+//*************************************************************************************************
+
+#ifndef _TRACE_BIN_H
+#define _TRACE_BIN_H
+
+//-------------------------------------------------------------------------------------------------
+//                                include
+//-------------------------------------------------------------------------------------------------
+#include <stdarg.h>
+
+#include "etcs_types.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//                                define & structure
+//-------------------------------------------------------------------------------------------------
+
+/// Default size of the ring of each thread (bytes, power of 2)
+#ifndef TRACE_BIN_RING_SIZE
+#define TRACE_BIN_RING_SIZE     (256*1024)
+#endif //TRACE_BIN_RING_SIZE
+
+/// Maximum number of formats (one per Trace call site)
+#define TRACE_BIN_MAX_FORMATS   4096
+
+/// Maximum number of arguments of one record (next arguments are not recorded)
+#define TRACE_BIN_MAX_ARGS      16
+
+/// Identifier of a binary trace file
+#define TRACE_BIN_MAGIC         0x54524342
+
+/// Version of the binary trace file format
+#define TRACE_BIN_VERSION       2
+
+/// Type of the records of a binary trace file
+typedef enum eTraceBinRecordType
+{
+    TRACE_BIN_REC_FORMAT = 0,   ///< Format description (STraceBinFormat followed by the format string)
+    TRACE_BIN_REC_EVENT     ,   ///< Trace event (STraceBinEvent followed by the arguments)
+    TRACE_BIN_REC_LOST          ///< Events lost because a ring was full (STraceBinEvent, uwNbArgs is the count)
+
+} eTraceBinRecordType;
+
+/// Header of a binary trace file
+typedef struct STraceBinFileHeader
+{
+    uint32_t    ulMagic                 ;   ///< TRACE_BIN_MAGIC
+    uint32_t    ulVersion               ;   ///< TRACE_BIN_VERSION
+    uint64_t    ullStartTime_ns         ;   ///< CLOCK_MONOTONIC time of the trace start (ns)
+    t_time      dStartTimeOfDay         ;   ///< Time of day of the trace start (s since epoch)
+
+} STraceBinFileHeader;
+
+/// Description of a format, written once before its first event
+typedef struct STraceBinFormat
+{
+    uint16_t    uwRecordType            ;   ///< TRACE_BIN_REC_FORMAT
+    uint16_t    uwFormatId              ;   ///< Identifier used by the events
+    uint16_t    uwLength                ;   ///< Length of the format string following the record (with final 0)
+    uint16_t    uwNbArgs                ;   ///< Number of arguments of the format
+
+} STraceBinFormat;
+
+/// Header of an event stored in a ring and in the file.
+/// It is followed by the arguments: 8 bytes per integer, double or pointer argument,
+/// for a string argument 8 bytes of length followed by the whole string (without final 0, padded to 8 bytes),
+/// so the decoded text is identical to the text log.
+typedef struct STraceBinEvent
+{
+    uint16_t    uwRecordType            ;   ///< TRACE_BIN_REC_EVENT or TRACE_BIN_REC_LOST
+    uint16_t    uwFormatId              ;   ///< Identifier of the format
+    uint16_t    uwNbArgs                ;   ///< Number of recorded arguments
+    uint16_t    uwModuleId              ;   ///< Module of the writing thread (eAddressId)
+    uint32_t    ulLength                ;   ///< Length of the arguments (bytes, multiple of 8)
+    uint32_t    ulThreadSeq             ;   ///< Event counter of the writing thread
+    uint64_t    ullTime_ns              ;   ///< CLOCK_MONOTONIC time of the event (ns)
+
+} STraceBinEvent;
+
+//-------------------------------------------------------------------------------------------------
+//                                function prototype
+//-------------------------------------------------------------------------------------------------
+
+/// Open the binary trace file and start the flush thread.
+/// Trace() records in the rings instead of writing text as long as CFG_BINARY_TRACE is set.
+/// @return true on success
+bool TraceBin_Init( const char *    szFileName      ,   ///< [in] binary trace file name
+                    uint32_t        ulRingSize      ,   ///< [in] size of the ring of each thread (power of 2, 0 for TRACE_BIN_RING_SIZE)
+                    int32_t         lFlushPeriod_ms     ///< [in] period of the flush thread (ms)
+                    );
+
+/// Create the ring of the calling thread (called once by each module thread before its first trace).
+/// Threads without ring write their traces as text.
+/// @return true on success
+bool TraceBin_AttachThread( eAddressId ModuleId     ///< [in] module of the calling thread
+                            );
+
+/// Flush and release the ring of the calling thread
+void TraceBin_DetachThread( void );
+
+/// Record a trace event in the ring of the calling thread (no formatting, no lock, no system call).
+/// The address of the format string is the key of the format: its arguments are parsed once, at the first call.
+/// The format must therefore be a string literal (Trace and TRACE_BIN check it at compile time):
+/// a format built at run time would get a new identifier at each call.
+/// When the ring is full, or the event is larger than the ring, the event is dropped and counted (see TraceBin_GetLostCount).
+/// When TRACE_BIN_MAX_FORMATS formats are registered, events of new formats are written as text.
+void TraceBin_VPrintf( const char *     szFormat    ,   ///< [in] printf format (string literal given to Trace)
+                       va_list          Args            ///< [in] arguments of the format
+                       );
+
+/// Record a trace event in the ring of the calling thread (use TRACE_BIN)
+void TraceBin_Printf( const char *      szFormat    ,   ///< [in] printf format (string literal)
+                      ...
+                      );
+
+/// Record a trace event, the format must be a string literal ("" _fmt does not compile otherwise)
+#define TRACE_BIN( _fmt, ... )  TraceBin_Printf( "" _fmt, ##__VA_ARGS__ )
+
+/// Write the content of all rings in the file (also done periodically by the flush thread)
+void TraceBin_Flush( void );
+
+/// Flush all rings, stop the flush thread and close the file
+void TraceBin_Close( void );
+
+/// Get the number of events dropped because a ring was full
+/// @return number of lost events since TraceBin_Init
+uint32_t TraceBin_GetLostCount( void );
+
+/// Decode a binary trace file into text logs (one file per module, same format as the text logs)
+/// @return number of decoded events, -1 if the file cannot be read
+int32_t TraceBin_Decode( const char *   szBinFileName   ,   ///< [in] binary trace file name
+                         const char *   szOutputDir         ///< [in] directory of the text log files
+                         );
+
+#ifdef __cplusplus
+}
+#endif
+#endif // _TRACE_BIN_H
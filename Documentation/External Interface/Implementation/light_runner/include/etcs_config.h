@@ -88,6 +88,18 @@ typedef enum eConfigData
     CFG_LOCAL_TIME_STAMP,                 ///< Request local time stamp otherwise GMT time in log & JRU record
     CFG_RECORDER_LOG_ADD_FULL_TIME_STAMP, ///< add time stamp in EuroCabLog.dat like 2009-05-29/08:15:21.29
 
+    CFG_COM_SHM_RING,       ///< External communications use shared memory rings (COM_SHM_RING) instead of message queues:
+                            ///< CEvc_com creates its facades (balise, odometry/TIU, DMI, JRU, radio) with COM_SHM_RING
+
+    CFG_DUMP_CYCLE_STATS,   ///< Write the cycle statistics of the modules in the log file on Stop
+    CFG_BINARY_TRACE,       ///< Record traces in binary rings flushed to one file instead of text log files
+    CFG_RECORD_CHROME_TRACE,///< Record module activity in Chrome trace event format (see SetChromeTraceParameters)
+
+    CFG_SHMEM_LAZY_COMMIT,  ///< Reserve the shared data without committing them (SharedData_Reserve, only the data read are initialised)
+    CFG_SHMEM_HUGE_PAGES,   ///< Use huge pages for the shared data, mostly curve data (with CFG_SHMEM_LAZY_COMMIT)
+    CFG_REALTIME_MODE,      ///< Lock and prefault memory, pin module threads and use SCHED_FIFO (see SetModuleCpuAffinity)
+    CFG_STEP_MODE,          ///< Module threads do not wait for their timers: time is simulated and advanced by Step (deterministic tests)
+
     CONFIG_SIZE
 } eConfigData;
 
@@ -102,6 +114,14 @@ typedef enum eConfigData
         Trace( "CFG_BAL_WITH_ODO_STAMP                 = %x\n", IsConfigSet( CFG_BAL_WITH_ODO_STAMP ) ); \
         Trace( "CFG_LOCAL_TIME_STAMP                   = %x\n", IsConfigSet( CFG_LOCAL_TIME_STAMP ) ); \
         Trace( "CFG_RECORDER_LOG_ADD_FULL_TIME_STAMP   = %x\n", IsConfigSet( CFG_RECORDER_LOG_ADD_FULL_TIME_STAMP ) ); \
+        Trace( "CFG_COM_SHM_RING                       = %x\n", IsConfigSet( CFG_COM_SHM_RING ) ); \
+        Trace( "CFG_DUMP_CYCLE_STATS                   = %x\n", IsConfigSet( CFG_DUMP_CYCLE_STATS ) ); \
+        Trace( "CFG_BINARY_TRACE                       = %x\n", IsConfigSet( CFG_BINARY_TRACE ) ); \
+        Trace( "CFG_RECORD_CHROME_TRACE                = %x\n", IsConfigSet( CFG_RECORD_CHROME_TRACE ) ); \
+        Trace( "CFG_SHMEM_LAZY_COMMIT                  = %x\n", IsConfigSet( CFG_SHMEM_LAZY_COMMIT ) ); \
+        Trace( "CFG_SHMEM_HUGE_PAGES                   = %x\n", IsConfigSet( CFG_SHMEM_HUGE_PAGES ) ); \
+        Trace( "CFG_REALTIME_MODE                      = %x\n", IsConfigSet( CFG_REALTIME_MODE ) ); \
+        Trace( "CFG_STEP_MODE                          = %x\n", IsConfigSet( CFG_STEP_MODE ) ); \
     }
 
 // -------------------------------------------------------------------------------------------------
@@ -47,6 +47,9 @@ language governing permissions and limitations under the License.
 #include <time.h>
 #include <pthread.h>
 #include <inttypes.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 
 #ifndef __cplusplus
  #include <stdbool.h>
@@ -58,6 +61,30 @@ language governing permissions and limitations under the License.
 
 #define _LIGHT_EVC_SHMEM_ 0
 
+/// Size of a cache line of the host (can be set at build time)
+#ifndef CACHE_LINE_SIZE
+ #define CACHE_LINE_SIZE 64
+#endif // CACHE_LINE_SIZE
+
+/// Alignment of a block of shared data written by one module thread (no false sharing with other blocks)
+#define CACHE_ALIGNED __attribute__( ( aligned( CACHE_LINE_SIZE ) ) )
+
+/// Build time check of the layout of shared data
+/// (array of negative size when static_assert is not available: C++98, C99)
+#define LAYOUT_ASSERT_NAME2( _a, _b ) _a##_b
+#define LAYOUT_ASSERT_NAME( _a, _b )  LAYOUT_ASSERT_NAME2( _a, _b )
+#if defined( __cplusplus ) && ( __cplusplus >= 201103L )
+ #define LAYOUT_ASSERT( _cond, _msg ) static_assert( _cond, _msg )
+#elif !defined( __cplusplus ) && defined( __STDC_VERSION__ ) && ( __STDC_VERSION__ >= 201112L )
+ #define LAYOUT_ASSERT( _cond, _msg ) _Static_assert( _cond, _msg )
+#else
+ #define LAYOUT_ASSERT( _cond, _msg ) typedef char LAYOUT_ASSERT_NAME( layout_assert_line_, __LINE__ )[ ( _cond ) ? 1 : -1 ]
+#endif
+
+/// Macro to test if a field of a structure starts a cache line
+#define IS_CACHE_ALIGNED( _type, _field ) \
+    ( ( offsetof( _type, _field ) % CACHE_LINE_SIZE ) == 0 )
+
 // ===========================  miscellaneous definition  =======================
 
 // Basic types
@@ -157,6 +184,11 @@ typedef double t_mass;     ///< mass in kg
 /// max nb of module in eurocab
 #define     MAX_MODULE_NB 20
 
+/// Number of radio equipments (can be set at build time, at least 2)
+#ifndef MAX_RADIO_EQUIPMENT
+#define MAX_RADIO_EQUIPMENT 2
+#endif // MAX_RADIO_EQUIPMENT
+
 #define     UNUSED( x ) (void) x;
 
 /// value send for force considerign SSCODE valid
@@ -411,10 +443,15 @@ typedef enum
     LOOP_COM_KEY, ///< key for the message queue for LOOP communication
     STM_COM_KEY,  ///< key for the message queue for STM communication
     JRU_COM_KEY,  ///< key for the message queue for JRU communication
+    RAD_COM_KEY_EXT, ///< key for the message queue for radio communication 3 (next equipments use the next keys)
 
-    MAX_KEY_VAL
+    MAX_KEY_VAL = RAD_COM_KEY_EXT + MAX_RADIO_EQUIPMENT - 2
 } eEVC_Key;
 
+/// Macro to get the key of the message queue of a radio equipment (0 to MAX_RADIO_EQUIPMENT-1)
+#define RAD_COM_KEY_OF( _id ) \
+    ( ( _id ) == 0 ? RAD_COM_KEY : ( _id ) == 1 ? RAD_COM_KEY2 : (int32_t) RAD_COM_KEY_EXT + ( _id ) - 2 )
+
 /// Structure to store time
 typedef struct STime
 {
@@ -857,13 +894,56 @@ typedef enum
     : ( d ) == ADDR_EVCCTRL_ID ? "ADDR_EVCCTRL_ID" \
     : ( d ) == ADDR_TEST_ID ? "ADDR_TEST_ID" : "???"
 
+/// Enumeration for priority class of internal messages (one lane per class in each mailbox)
+typedef enum eMsgPriority
+{
+    MSG_PRIO_SAFETY = 0, ///< brake commands and train trip
+    MSG_PRIO_CONTROL,    ///< track, mode and radio data
+    MSG_PRIO_DISPLAY,    ///< DMI messages
+    MSG_PRIO_RECORD,     ///< recorder and JRU messages
+    MSG_PRIO_NB          ///< Number of priority classes
+} eMsgPriority;
+
+/// Macro to get the string corresponding to a message priority class
+#define STR_MSG_PRIORITY( d ) \
+    ( ( d ) == MSG_PRIO_SAFETY ? "SAFETY" \
+    : ( d ) == MSG_PRIO_CONTROL ? "CONTROL" \
+    : ( d ) == MSG_PRIO_DISPLAY ? "DISPLAY" \
+    : ( d ) == MSG_PRIO_RECORD ? "RECORD" : "???" )
+
+/// Enumeration for external inputs at the origin of internal messages (latency measurement)
+typedef enum eExternalInput
+{
+    EXT_INPUT_NONE = 0, ///< No external input (internal event)
+    EXT_INPUT_BALISE,   ///< Balise telegram
+    EXT_INPUT_RADIO,    ///< Radio message
+    EXT_INPUT_ODO,      ///< Odometric data
+    EXT_INPUT_TIU,      ///< Train interface inputs
+    EXT_INPUT_DMI,      ///< Driver action on DMI
+    EXT_INPUT_NB        ///< Number of external inputs
+} eExternalInput;
+
+/// Macro to get the string corresponding to an external input
+#define STR_EXTERNAL_INPUT( d ) \
+    ( ( d ) == EXT_INPUT_NONE ? "NONE" \
+    : ( d ) == EXT_INPUT_BALISE ? "BALISE" \
+    : ( d ) == EXT_INPUT_RADIO ? "RADIO" \
+    : ( d ) == EXT_INPUT_ODO ? "ODO" \
+    : ( d ) == EXT_INPUT_TIU ? "TIU" \
+    : ( d ) == EXT_INPUT_DMI ? "DMI" : "???" )
+
 /// structure for transmission of internal message via message queue
 typedef struct SIntMessage
 {
-    eAddressId DestId;    ///< Identity of the receiver
-    eAddressId SendId;    ///< Identity of the sender
-    int32_t    lMessSize; ///< Message size in bytes
-    eMsgCode   AppCod;    ///< Application code
+    eAddressId     DestId;           ///< Identity of the receiver
+    eAddressId     SendId;           ///< Identity of the sender
+    int32_t        lMessSize;        ///< Message size in bytes
+    eMsgCode       AppCod;           ///< Application code
+    eMsgPriority   Priority;         ///< Priority class
+    eExternalInput OriginInput;      ///< External input at the origin of the message
+    uint64_t       ullOriginTime_ns; ///< Time of reception of the external input (ns, CLOCK_MONOTONIC, 0 if none)
+    uint64_t       ullSendTime_ns;   ///< Time of the send (ns, CLOCK_MONOTONIC)
+    uint64_t       ullRecvTime_ns;   ///< Time of the receive (ns, CLOCK_MONOTONIC, set by the receiver)
 } SIntMessage;
 
 /// Maximum size of the data exchanged between modules (in bytes)
@@ -879,11 +959,277 @@ typedef struct SInternalMsg
     char       szData[ MAX_DATA_SIZE ]; ///< Data included in the message
 } SInternalMsg;
 
+/// Structure containing the statistics of one lane of a mailbox
+typedef struct SMailboxLaneStats
+{
+    int32_t  lDepth;        ///< Number of messages waiting in the lane
+    int32_t  lMaxDepth;     ///< Maximum number of waiting messages since last reset
+    uint32_t ulSentCnt;     ///< Number of messages sent to the lane since last reset
+    uint32_t ulReceivedCnt; ///< Number of messages read from the lane since last reset
+    uint32_t ulFullCnt;     ///< Number of send delayed because the mailbox was full
+    t_time   dMaxWaitTime;  ///< Maximum time spent by a message in the lane (s)
+} SMailboxLaneStats;
+
+/// Structure containing the statistics of the mailbox of one module
+typedef struct SMailboxStats
+{
+    eAddressId        ModuleId;             ///< Owner of the mailbox
+    SMailboxLaneStats aLane[ MSG_PRIO_NB ]; ///< Statistics of each lane (index is eMsgPriority)
+} SMailboxStats;
+
+/// Number of bits of the sub-buckets of a histogram: 2^HISTO_SUB_BITS buckets per power of 2
+#define HISTO_SUB_BITS 4
+
+/// Number of sub-buckets per power of 2 (relative precision of a histogram is 1/HISTO_SUB_NB)
+#define HISTO_SUB_NB ( 1 << HISTO_SUB_BITS )
+
+/// Number of buckets of a histogram (covers the whole uint32_t range)
+#define HISTO_BUCKET_NB ( ( 2 + 31 - HISTO_SUB_BITS ) * HISTO_SUB_NB )
+
+/// Histogram of durations in microseconds with logarithmic buckets (HDR style)
+typedef struct SHistogram
+{
+    uint32_t aulCount[ HISTO_BUCKET_NB ]; ///< Number of samples of each bucket
+    uint64_t ullTotalCount;               ///< Number of samples
+    uint64_t ullSum_us;                   ///< Sum of the samples (us)
+    uint32_t ulMin_us;                    ///< Minimum sample (us)
+    uint32_t ulMax_us;                    ///< Maximum sample (us)
+} SHistogram;
+
+/// Structure containing the cycle statistics of one module thread
+typedef struct SModuleCycleStats
+{
+    eAddressId ModuleId;        ///< Module identity (ADDR_EVCCTRL_ID for the EVC controller)
+    int32_t    lPeriod;         ///< Module period (ms)
+    SHistogram CycleTime;       ///< Processing time of the cycles (us)
+    SHistogram WakeUpJitter;    ///< Delay between planned and actual wake-up (us)
+    uint32_t   ulOverrunCnt;    ///< Number of cycles ended after the next planned wake-up
+    uint32_t   ulMaxOverrun_us; ///< Longest overrun (us)
+    uint32_t   ulResetRqst;     ///< Reset request taken by the module at the top of its next cycle
+                                ///< (only accessed with CycleStats_RequestReset and CycleStats_TakeResetRqst)
+} SModuleCycleStats;
+
+/// Enumeration for grouping of the message latency statistics
+typedef enum eMsgLatencyGroup
+{
+    MSG_LATENCY_BY_CODE = 0, ///< One entry per application code
+    MSG_LATENCY_BY_ADDRESS   ///< One entry per sender / receiver pair
+} eMsgLatencyGroup;
+
+/// Structure containing the latency statistics of a group of internal messages
+typedef struct SMsgLatencyStats
+{
+    eMsgCode   AppCode;        ///< Code of the messages (MAX_APP_CODE when grouped by address)
+    eAddressId SendId;         ///< Sender of the messages (ADDR_ALL when grouped by code)
+    eAddressId DestId;         ///< Receiver of the messages (ADDR_ALL when grouped by code)
+    SHistogram QueueTime;      ///< Time between send and receive (us)
+    SHistogram ProcessingTime; ///< Time between receive and end of processing by the receiver (us)
+} SMsgLatencyStats;
+
+/// Structure containing the latency statistics from an external input to the TIU outputs
+typedef struct SInputLatencyStats
+{
+    eExternalInput Input;     ///< External input
+    SHistogram     ToTiuTime; ///< Time between the input and the resulting TIU output transition (us)
+} SInputLatencyStats;
+
+/// Enumeration for the brake interventions monitored for reaction time
+typedef enum eBrakeReaction
+{
+    BRAKE_REACTION_EB = 0, ///< EBI crossed until bEB_App set
+    BRAKE_REACTION_SB,     ///< SBI crossed until bSB_App set
+    BRAKE_REACTION_NB      ///< Number of monitored interventions
+} eBrakeReaction;
+
+/// Macro to get the string corresponding to a monitored intervention
+#define STR_BRAKE_REACTION( d ) \
+    ( ( d ) == BRAKE_REACTION_EB ? "EB" \
+    : ( d ) == BRAKE_REACTION_SB ? "SB" : "???" )
+
+/// Structure containing the reaction time statistics of one brake intervention
+typedef struct SReactionTimeStats
+{
+    eBrakeReaction Type;                   ///< Monitored intervention
+    t_time         dBound;                 ///< Maximum allowed reaction time (s, 0 if not checked)
+    SHistogram     ReactionTime;           ///< Reaction times (us)
+    uint32_t       ulInterventionCnt;      ///< Number of interventions
+    uint32_t       ulViolationCnt;         ///< Number of reaction times above the bound
+    t_time         dLastViolationTime;     ///< Simulation time of the last violation (s)
+    t_distance     dLastViolationLocation; ///< Train location of the last violation (m)
+} SReactionTimeStats;
+
+/// Enumeration for the structures of the shared data (memory usage)
+typedef enum eSharedDataBlock
+{
+    SHDATA_ETCS_IO = 0, ///< Main EVC data (ETCS_IO)
+    SHDATA_CONFIG,      ///< EVC configuration (Config)
+    SHDATA_CURVE_SETS,  ///< Slots of the supervision curve sets (ShCurveSets)
+    SHDATA_SUPERVISION, ///< Supervision data and snapshot (ShSupervisionData, ShSnapshot)
+    SHDATA_TEMPORARY,   ///< Temporary data (ShTemporaryDataBig)
+    SHDATA_STATIC,      ///< Static data of the modules (EVCStaticData)
+    SHDATA_NB           ///< Number of structures
+} eSharedDataBlock;
+
+/// Macro to get the string corresponding to a structure of the shared data
+#define STR_SHARED_DATA_BLOCK( d ) \
+    ( ( d ) == SHDATA_ETCS_IO ? "etcs_io" \
+    : ( d ) == SHDATA_CONFIG ? "config" \
+    : ( d ) == SHDATA_CURVE_SETS ? "curve_sets" \
+    : ( d ) == SHDATA_SUPERVISION ? "supervision" \
+    : ( d ) == SHDATA_TEMPORARY ? "temporary" \
+    : ( d ) == SHDATA_STATIC ? "static" : "???" )
+
+/// Structure containing the memory used by one structure of the shared data
+typedef struct SSharedDataUsage
+{
+    uint64_t ullSizeBytes;     ///< Size of the structure
+    uint64_t ullResidentBytes; ///< Part of the structure in memory (pages already written)
+} SSharedDataUsage;
+
+/// Structure containing the counters of resources used by the EVC since Init (for long runs)
+typedef struct SResourceUsage
+{
+    uint64_t ullCurveComputeCnt;         ///< Number of computations of the supervision curves
+    uint64_t ullCurveComputeTime_us;     ///< Total time spent in curve computations (us)
+    uint64_t ullMsgCnt[ MAX_APP_CODE ];  ///< Number of internal messages sent per application code
+    uint64_t ullCSVBytes;                ///< Bytes written in the CSV file
+    uint64_t ullJRUBytes;                ///< Bytes written in the JRU file
+    uint64_t ullLogBytes;                ///< Bytes written in the log files (text or binary trace)
+    uint64_t ullSharedMemBytes;          ///< Size of the shared memories (ETCS IO, config, curves, supervision, temporary, static)
+    SSharedDataUsage SharedData[ SHDATA_NB ]; ///< Memory used by each structure of the shared data (index is eSharedDataBlock)
+    uint64_t ullHeapBytes;               ///< Heap memory in use by the EVC process (mallinfo)
+    uint64_t ullResidentBytes;           ///< Resident memory of the EVC process
+    uint64_t ullCycleAllocCnt;           ///< Heap allocations done by the periodic path once running (built with EVC_COUNT_ALLOCATIONS)
+} SResourceUsage;
+
+/// Structure containing the duration of the startup phases (Init, Start_processes and Run)
+typedef struct SStartupTiming
+{
+    t_time   dSharedDataTime;         ///< Reservation and initialisation of the shared data (s)
+    t_time   dConfigTime;             ///< Default configuration and static data (s)
+    t_time   dInterfaceTime;          ///< Creation of the external and internal communications (s)
+    t_time   dLogFileTime;            ///< Opening of the log, JRU and CSV files (s)
+    t_time   dThreadStartTime;        ///< Creation of the module threads until all are waiting (s)
+    t_time   dFirstCycleTime;         ///< From Run to the end of the first supervision cycle (s)
+    t_time   dTotalTime;              ///< From Init to the end of the first supervision cycle (s)
+    uint64_t ullSharedReservedBytes;  ///< Size of the shared data
+    uint64_t ullSharedCommittedBytes; ///< Part of the shared data in memory at the end of the first cycle
+    bool     bHugePages;              ///< Huge pages are used for the curve data
+} SStartupTiming;
+
+/// Structure containing the status of the real-time execution (CFG_REALTIME_MODE), counters start at Run
+typedef struct SRealTimeStats
+{
+    bool       bMemoryLocked;     ///< Process memory is locked (mlockall) and the shared data are prefaulted
+    uint64_t   ullLockedBytes;    ///< Size of the prefaulted shared data
+    int32_t    lFifoThreadNb;     ///< Number of module threads running with SCHED_FIFO
+    int32_t    lPinnedThreadNb;   ///< Number of module threads pinned to a CPU
+    uint64_t   ullMinorFaultCnt;  ///< Minor page faults of the module threads
+    uint64_t   ullMajorFaultCnt;  ///< Major page faults of the module threads
+    uint32_t   ulDeadlineMissCnt; ///< Module cycles ended after the next planned wake-up (all modules)
+    eAddressId LastMissModuleId;  ///< Module of the last deadline miss
+    t_time     dLastMissTime;     ///< Simulation time of the last deadline miss (s)
+} SRealTimeStats;
+
+/// Get the bucket of a value
+static inline int32_t Histo_Index( uint32_t ulValue_us )
+{
+    int32_t lShift;
+
+    if( ulValue_us < 2 * HISTO_SUB_NB )
+    {
+        return (int32_t)ulValue_us;
+    }
+
+    lShift = 31 - __builtin_clz( ulValue_us ) - HISTO_SUB_BITS;
+    return HISTO_SUB_NB * ( lShift + 1 ) + (int32_t)( ulValue_us >> lShift ) - HISTO_SUB_NB;
+}
+
+/// Get the highest value of a bucket
+static inline uint32_t Histo_UpperValue( int32_t lIndex )
+{
+    int32_t lShift;
+
+    if( lIndex < 2 * HISTO_SUB_NB )
+    {
+        return (uint32_t)lIndex;
+    }
+
+    lShift = lIndex / HISTO_SUB_NB - 1;
+    return ( ( (uint32_t)( lIndex % HISTO_SUB_NB + HISTO_SUB_NB + 1 ) ) << lShift ) - 1;
+}
+
+/// Clear all the samples of a histogram (only by the thread recording its samples, see Histo_Record)
+static inline void Histo_Reset( SHistogram* pHisto )
+{
+    memset( pHisto, 0, sizeof( SHistogram ) );
+    pHisto->ulMin_us = UINT32_MAX;
+}
+
+/// Add a sample to a histogram (single writer: other threads only read it or request its reset)
+static inline void Histo_Record( SHistogram* pHisto, uint32_t ulValue_us )
+{
+    pHisto->aulCount[ Histo_Index( ulValue_us ) ]++;
+    pHisto->ullTotalCount++;
+    pHisto->ullSum_us += ulValue_us;
+
+    if( ulValue_us < pHisto->ulMin_us )
+    {
+        pHisto->ulMin_us = ulValue_us;
+    }
+
+    if( ulValue_us > pHisto->ulMax_us )
+    {
+        pHisto->ulMax_us = ulValue_us;
+    }
+}
+
+/// Get the value below which the given percentage of samples are (upper value of the bucket, at most the maximum)
+/// @return value in us, 0 if the histogram is empty
+static inline uint32_t Histo_Percentile( const SHistogram* pHisto, double dPercent )
+{
+    uint64_t ullLimit = (uint64_t)( dPercent * (double)pHisto->ullTotalCount / 100.0 + 0.5 );
+    uint64_t ullCount = 0;
+    int32_t  lIndex;
+
+    if( pHisto->ullTotalCount == 0 )
+    {
+        return 0;
+    }
+
+    for( lIndex = 0; lIndex < HISTO_BUCKET_NB; lIndex++ )
+    {
+        ullCount += pHisto->aulCount[ lIndex ];
+        if( ullCount >= ullLimit && ullCount > 0 )
+        {
+            return Histo_UpperValue( lIndex ) < pHisto->ulMax_us ? Histo_UpperValue( lIndex ) : pHisto->ulMax_us;
+        }
+    }
+
+    return pHisto->ulMax_us;
+}
+
+/// Request the reset of the cycle statistics of a module (any thread).
+/// Release: the statistics read before the request are not affected by the reset.
+static inline void CycleStats_RequestReset( SModuleCycleStats* pStats )
+{
+    __atomic_store_n( &pStats->ulResetRqst, 1, __ATOMIC_RELEASE );
+}
+
+/// Take the reset request of a module, called by the module only, at the top of its cycle.
+/// Acquire: the module sees everything done by the requesting thread before the request.
+/// @return true when the module has to clear its histograms (Histo_Reset)
+static inline bool CycleStats_TakeResetRqst( SModuleCycleStats* pStats )
+{
+    return ( __atomic_exchange_n( &pStats->ulResetRqst, 0, __ATOMIC_ACQ_REL ) != 0 );
+}
+
 /// enumeration of type of communication
 typedef enum
 {
     NO_COM_TYPE,   ///< no communication
     COM_MSG_QUEUE, ///< communication via message queue
+    COM_SHM_RING,  ///< communication via shared memory ring (variable length messages)
 } eComType;
 
 /// Structure used to send /receive data via message queue
@@ -913,6 +1259,10 @@ typedef struct SComParam
     void*    pPipe;                                             ///< pointer on the pipe management
     char     szTxPipeName[ MAX_PIPE_NAME_SIZE ];                ///< Name of the pipe used to send data
     char     szRxPipeName[ MAX_PIPE_NAME_SIZE ];                ///< Name of the pipe used to receive data
+
+    uint32_t ulRingSize;                                        ///< Size of the data area of the shared memory rings (COM_SHM_RING)
+    void*    pTxRing;                                           ///< Pointer on the mapped ring used to send data (COM_SHM_RING)
+    void*    pRxRing;                                           ///< Pointer on the mapped ring used to receive data (COM_SHM_RING)
 } SComParam;
 
 /// Enumeration for direction or data orientation
@@ -974,6 +1324,41 @@ typedef struct STxTiuData
     ePlatformPosition  platformPosition;   ///< Track condition platform elevation
 } STxTiuData;
 
+/// Bits of the mask of changed fields of STxTiuData
+#define TX_TIU_CUT_OFF       0x00000001 ///< bCut_Off_App
+#define TX_TIU_SB            0x00000002 ///< bSB_App
+#define TX_TIU_EB            0x00000004 ///< bEB_App
+#define TX_TIU_OPEN_CB       0x00000008 ///< bOpenCircuitBreaker
+#define TX_TIU_PANTO_LOW     0x00000010 ///< bPantographLow
+#define TX_TIU_AIR_TIGHT     0x00000020 ///< bAirTightRqst
+#define TX_TIU_REGEN_BRAKE   0x00000040 ///< bPermitRegenBrake
+#define TX_TIU_EDDY_SB       0x00000080 ///< bPermitEddyCurrBrakeForSB
+#define TX_TIU_EDDY_EB       0x00000100 ///< bPermitEddyCurrBrakeForEB
+#define TX_TIU_MAGN_SHOE     0x00000200 ///< bPermitMagnShoeBrake
+#define TX_TIU_BAL_ANTENNA   0x00000400 ///< bSwitchOffBalAntenna
+#define TX_TIU_CONSUMPTION   0x00000800 ///< lAllowedConsumption
+#define TX_TIU_ISOLATION     0x00001000 ///< bIsolationStatus
+#define TX_TIU_PLATFORM_ELEV 0x00002000 ///< platformElevation
+#define TX_TIU_PLATFORM_POS  0x00004000 ///< platformPosition
+#define TX_TIU_ALL           0x00007FFF ///< All fields
+
+/// Maximum number of TIU output events waiting to be read
+#define TIU_EVENT_QUEUE_SIZE 64
+
+/// structure for transition of Tiu data (EVC-->TRAIN)
+typedef struct STxTiuEvent
+{
+    STxTiuData TiuData;       ///< TIU outputs after the transition
+    uint32_t   ulChangedMask; ///< Fields changed by the transition (TX_TIU_xxx)
+    uint32_t   ulSequence;    ///< Event counter (a gap indicates lost events, TiuData is still complete)
+    t_time     dTimeStamp;    ///< Time of the transition (s, CLOCK_MONOTONIC)
+    int32_t    lOriginInput;  ///< External input at the origin of the transition (eExternalInput)
+    t_time     dOriginTime;   ///< Time of reception of this input (s, CLOCK_MONOTONIC, 0 if none)
+} STxTiuEvent;
+
+/// Function called on each TIU output transition (in the thread of the train interface manager)
+typedef void ( *t_TiuEventCallback )( const STxTiuEvent * pEvent, void * pContext );
+
 /// structure for reception of Tiu data (TRAIN-->EVC)
 typedef struct SRxTiuData
 {
@@ -1000,6 +1385,30 @@ typedef struct SRxTiuData
     bool    bSystFailure;         ///< Indicate a system failure
 } SRxTiuData;
 
+/// Bits of the mask of changed fields of SRxTiuData
+#define RX_TIU_MAIN_SWITCH     0x00000001 ///< bMainSwitchOn
+#define RX_TIU_INTEGRITY       0x00000002 ///< bTrainIntegrityOK
+#define RX_TIU_CABIN           0x00000004 ///< ActiveCabin
+#define RX_TIU_ISOLATION       0x00000008 ///< bIsolation
+#define RX_TIU_SLEEPING        0x00000010 ///< bSleeping
+#define RX_TIU_DIRECTION       0x00000020 ///< DirectionCtrl
+#define RX_TIU_EB_STATUS       0x00000040 ///< bEBStatus
+#define RX_TIU_SB_STATUS       0x00000080 ///< bSBStatus
+#define RX_TIU_NON_LEADING     0x00000100 ///< bNonLeading
+#define RX_TIU_PASSIVE_SH      0x00000200 ///< bPassiveSH
+#define RX_TIU_COLD_MVT        0x00000400 ///< bColdMvtStatus
+#define RX_TIU_TRAIN_DATA_TYPE 0x00000800 ///< lTrainDataType
+#define RX_TIU_REGEN_BRAKE     0x00001000 ///< bRegenBrake
+#define RX_TIU_MAGN_SHOE       0x00002000 ///< bMagnetShoeBrake
+#define RX_TIU_EDDY_BRAKE      0x00004000 ///< bEddyBrake
+#define RX_TIU_EP_BRAKE        0x00008000 ///< bEpBrake
+#define RX_TIU_ADD_BRAKE       0x00010000 ///< bAddBrake
+#define RX_TIU_BRAKE_PRESSURE  0x00020000 ///< dBrakePressure
+#define RX_TIU_HANDLE_POS      0x00040000 ///< lTractBrakeHandlePos
+#define RX_TIU_TRACTION        0x00080000 ///< bTractionOn
+#define RX_TIU_SYST_FAILURE    0x00100000 ///< bSystFailure
+#define RX_TIU_ALL             0x001FFFFF ///< All fields
+
 // ===========================  DMI Actions  =======================
 
 typedef enum eDriverActionInfo
@@ -4162,8 +4571,14 @@ typedef struct STrainCharact
 /// Special value for unknown RBC ID
 #define UNKNOWN_RBC_ID 16383
 
-/// Number of radio equipments
-#define MAX_RADIO_EQUIPMENT 2
+/// Structure describing one radio message of a batch (data stored in an arena given by the caller)
+typedef struct SRadioMsgDesc
+{
+    int32_t  lEquipmentID; ///< Radio equipment ID of the message
+    uint32_t ulOffset;     ///< Offset of the message in the arena (bytes)
+    uint32_t ulLength;     ///< Length of the message (bytes)
+    t_time   dTimeStamp;   ///< Time at which the message has been sent or received (s)
+} SRadioMsgDesc;
 
 /// Enumeration for radio link status
 typedef enum eRadioLinkState
@@ -4229,6 +4644,17 @@ typedef enum eRadSessionState
     SESSION_TERMINATED   ///< Session is terminated (wait for ack termination)
 } eRadSessionState;
 
+/// Structure containing the status of one radio equipment
+typedef struct SRadioEquipmentStatus
+{
+    int32_t               lEquipmentID;               ///< Radio equipment ID
+    eRadSafeConnectStatus SafeConnectionStatus;       ///< State of radio safe connection
+    eRadSessionState      CommunicationSessionStatus; ///< State of radio communication session
+    bool                  bRIU;                       ///< Indicates if connected to a radio infill unit or a radio block centre
+    int32_t               lRBCCountry;                ///< Country identifier of connected RBC or RIU
+    int32_t               lRBCIdentity;               ///< Identifier of connected RBC or RIU
+} SRadioEquipmentStatus;
+
 /// Enumeration for status of the radio network registration
 typedef enum eRadNetRegState
 {
@@ -4619,10 +5045,9 @@ typedef enum eTrainDataType
     : ( d ) == TRAIN_DATA_FIXED ? "Fixed" \
     : ( d ) == TRAIN_DATA_SWITCHABLE ? "Switchable" : "UNKNOWN TRAIN DATA TYPE"
 
-/// Structure containing TIU Input/Output
-typedef struct STiuData
+/// Structure containing the TIU outputs (commands to the train, written by the speed controller)
+typedef struct STiuOutputs
 {
-    // OUTPUTS
     bool    bEBApp;                 ///< Indicates if EB is requested
     bool    bSBApp;                 ///< Indicates if SB is requested
     bool    bCutOffApp;             ///< Indicates if cut off traction is requested
@@ -4634,8 +5059,11 @@ typedef struct STiuData
     bool    bPermitEddyBrakeForEB;  ///< Indicates if eddy current brake is permitted for EB
     bool    bPermitMagnetShoeBrake; ///< Indicates if magnetic shoe brake is permitted
     int32_t lAllowedConsumption;    ///< Indicates the allowed consumption (Ampere)
+} STiuOutputs;
 
-    // INPUTS
+/// Structure containing the TIU inputs (status of the train, written by the train interface manager)
+typedef struct STiuInputs
+{
     bool               bMainSwitchOn;              ///< Indicates if power is on
     bool               bTrainIntegrityOK;          ///< Indicates if integrity is OK
     eActiveCabin       ActiveCabin;                ///< Current active cabin status
@@ -4662,7 +5090,7 @@ typedef struct STiuData
     ePlatformPosition  platformPosition;     ///< current track condition platform position
     ePlatformElevation platformElevation;    ///< current track condition platform elevation
     bool               bSystemFailure;       ///< Indication of system failure
-} STiuData;
+} STiuInputs;
 
 // =======================    Permitted speed curve    =======================
 
@@ -4737,68 +5165,97 @@ typedef struct SLRBG
 } SLRBG;
 
 /// Structure containing the main EVC data (status, location, ...)
-/// It corresponds to a shared memory of the EVC simulator
+/// It corresponds to a shared memory of the EVC simulator.
+/// Fields are grouped in blocks aligned on a cache line, each written by one module thread only.
 typedef struct SETCS_IO
 {
-    SOnBoardStatus    OBStatus;                     ///< Onboard status
-
-    bool              bSuperviseSVL;                ///< Indicate if SvL = EoA or not (See Q_MAMODE)
-    t_distance        dNextModeChangeLoc;           ///< Location for the next mode transition (on-sight or shunting)
-    bool              bEmergencyStop;               ///< Indicates if an emergency stop is required
-
-    STiuData          TiuData;                      ///< TIU inputs/outputs
-
-    SLocationData     LocationData;                 ///< Train location data
-
-    STrackCondCurrent TrackConditionData; ///< Track condition data
-
-    eValidity         Position_Validity;            ///< State of the train location data
-
-    // Balises
-    SBG_Id       LastBGId;                ///< Last passed balise group
-    SLRBG        LRBGList[ MAX_LRBG_NB ]; ///< List of passed balise group (the first is the last passed)
-    SLinkingData LinkingData;             ///< Linking data
-    uint32_t     uMissedBG;               ///< Identifier of the missed or ignored BG due to linking
-
-    int32_t      lGradientValue;        ///< Current gradient value according to track description
-
-    bool         bTripActive;                       ///< Indicates if transition to trip mode is available
-    bool         bMA_Data;                          ///< Indicates if some MA data are available
-    bool         bModeProfileSH;                    ///< Indicates if mode profile for SH is available
-    bool         bTMAR_MARequested;                 ///< Indicates if TMAR triggered MA has been requested
-    bool         bTrackDeleted;                     ///< Indicates if the track description has been deleted
-    bool         bTksMsgInProcessing;               ///< Indicates if a trackside msg is in processing
-
-    eSpeedMonitoringStatus SpeedMonitStatus;         ///< Status of current speed monitoring (CSM, PIM...)
-    t_distance             dIP_Location;             ///< IP location for target indication
-    t_distance             dPreIPLocation;           ///< Pre-IP location for target indication
-    t_distance             BrakeTargetType;          ///< Type of the next target
-    t_distance             dBrakeTargetLoc;          ///< Next brake target location
-    t_speed                dBrakeTargetSpeed;        ///< Next brake target speed
-    bool                   bInTargetSpeedMonitoring; ///< Indicates if currently in target speed monitoring
-    bool                   bFeedbackStarted;         ///< boolean stating whereas the feedback function has started to reduce Tbs
-
-    t_speed                dPredicted_Speed;        ///< Predicted speed at target location
-    t_distance             dPredicted_Dist;         ///< Predicted distance where train reaches standstill
-
-    eInterventionType      Int_Type;                ///< Type of intervention
-    t_distance             dInterventionDist;       ///< Distance for intervention
-    t_time                 dInterventionTime;       ///< Time for intervention
-
-    bool                   bIntegrityFromDriver;    ///< Indicates if driver confirmed train integrity
-    bool                   bRouteUnsuitability;     ///< Indicates if route unsuitability is applicable
-    t_distance             dUnSuitabilityLoc;       ///< Location of route unsuitability
-
-    bool                   bRunning;                ///< Indicates if simulation is running
-    bool                   bPaused;                 ///< Indicates if simulation is currently paused
-    t_time                 dStartTime;              ///< Simulation start time
-    t_time                 dElapsedTime;            ///< Elapsed simulation time (used when saving and loading context)
-    t_time                 dPauseStartTime;         ///< Current pause start time
-    t_time                 dPauseTotalTime;         ///< Total pause time
-
-    SPerSpeedData          PerSpeedData;            ///< Data for permitted speed curves
+    /// Block written by the mode manager
+    struct CACHE_ALIGNED
+    {
+        SOnBoardStatus OBStatus;             ///< Onboard status
+        bool           bSuperviseSVL;        ///< Indicate if SvL = EoA or not (See Q_MAMODE)
+        t_distance     dNextModeChangeLoc;   ///< Location for the next mode transition (on-sight or shunting)
+        bool           bEmergencyStop;       ///< Indicates if an emergency stop is required
+        bool           bTripActive;          ///< Indicates if transition to trip mode is available
+        bool           bModeProfileSH;       ///< Indicates if mode profile for SH is available
+        bool           bIntegrityFromDriver; ///< Indicates if driver confirmed train integrity
+        bool           bRouteUnsuitability;  ///< Indicates if route unsuitability is applicable
+        t_distance     dUnSuitabilityLoc;    ///< Location of route unsuitability
+    } Mode;
+
+    /// Block written by the odometer interface (every odometer cycle)
+    struct CACHE_ALIGNED
+    {
+        SLocationData LocationData;      ///< Train location data
+        eValidity     Position_Validity; ///< State of the train location data
+        int32_t       lGradientValue;    ///< Current gradient value according to track description
+    } Odo;
+
+    /// Block written by the train interface manager on TIU input changes only
+    STiuInputs TiuInputs CACHE_ALIGNED; ///< TIU inputs
+
+    /// Block written by the speed controller on brake and traction command changes only
+    STiuOutputs TiuOutputs CACHE_ALIGNED; ///< TIU outputs
+
+    /// Block written by the balise interface
+    struct CACHE_ALIGNED
+    {
+        SBG_Id       LastBGId;                ///< Last passed balise group
+        SLRBG        LRBGList[ MAX_LRBG_NB ]; ///< List of passed balise group (the first is the last passed)
+        SLinkingData LinkingData;             ///< Linking data
+        uint32_t     uMissedBG;               ///< Identifier of the missed or ignored BG due to linking
+    } Balise;
+
+    /// Block written by the data manager (trackside data)
+    struct CACHE_ALIGNED
+    {
+        STrackCondCurrent TrackConditionData;  ///< Track condition data
+        bool              bMA_Data;            ///< Indicates if some MA data are available
+        bool              bTMAR_MARequested;   ///< Indicates if TMAR triggered MA has been requested
+        bool              bTrackDeleted;       ///< Indicates if the track description has been deleted
+        bool              bTksMsgInProcessing; ///< Indicates if a trackside msg is in processing
+    } Data;
+
+    /// Block written by the speed controller
+    struct CACHE_ALIGNED
+    {
+        eSpeedMonitoringStatus SpeedMonitStatus;         ///< Status of current speed monitoring (CSM, PIM...)
+        t_distance             dIP_Location;             ///< IP location for target indication
+        t_distance             dPreIPLocation;           ///< Pre-IP location for target indication
+        t_distance             BrakeTargetType;          ///< Type of the next target
+        t_distance             dBrakeTargetLoc;          ///< Next brake target location
+        t_speed                dBrakeTargetSpeed;        ///< Next brake target speed
+        bool                   bInTargetSpeedMonitoring; ///< Indicates if currently in target speed monitoring
+        bool                   bFeedbackStarted;         ///< boolean stating whereas the feedback function has started to reduce Tbs
+        t_speed                dPredicted_Speed;         ///< Predicted speed at target location
+        t_distance             dPredicted_Dist;          ///< Predicted distance where train reaches standstill
+        eInterventionType      Int_Type;                 ///< Type of intervention
+        t_distance             dInterventionDist;        ///< Distance for intervention
+        t_time                 dInterventionTime;        ///< Time for intervention
+        SPerSpeedData          PerSpeedData;             ///< Data for permitted speed curves
+    } Ctrl;
+
+    /// Block written by the simulation control
+    struct CACHE_ALIGNED
+    {
+        bool   bRunning;        ///< Indicates if simulation is running
+        bool   bPaused;         ///< Indicates if simulation is currently paused
+        t_time dStartTime;      ///< Simulation start time
+        t_time dElapsedTime;    ///< Elapsed simulation time (used when saving and loading context)
+        t_time dPauseStartTime; ///< Current pause start time
+        t_time dPauseTotalTime; ///< Total pause time
+    } Sim;
 } SETCS_IO;
 
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, Mode ), "SETCS_IO: mode manager block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, Odo ), "SETCS_IO: odometer interface block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, TiuInputs ), "SETCS_IO: TIU inputs block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, TiuOutputs ), "SETCS_IO: TIU outputs block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, Balise ), "SETCS_IO: balise interface block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, Data ), "SETCS_IO: data manager block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, Ctrl ), "SETCS_IO: speed controller block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SETCS_IO, Sim ), "SETCS_IO: simulation control block not aligned" );
+
 /// Maximum number of targets
 #define     MAX_TARGET_NB 256
 
@@ -4857,9 +5314,6 @@ typedef struct SAck_Msg_Result
 ///       enough memory (in this case, it is writing to a file: the swap)
 typedef struct STemporaryDataBig
 {
-    STrackDesc TrackDesc1; ///< First  data set for MRSP and gradient track description (can be used while second set is being computed)
-    STrackDesc TrackDesc2; ///< Second data set for MRSP and gradient track description (can be used while first  set is being computed)
-
     t_curve    TempCurve1;    ///< First  data set for temporary data used for curve calculation (can be used while second set is being computed)
     t_curve    TempCurve2;    ///< Second data set for temporary data used for curve calculation (can be used while first  set is being computed)
 } STemporaryDataBig;
@@ -4896,103 +5350,202 @@ typedef struct SMovementBound
 
 // =======================    Supervision data    =======================
 
-/// Enumeration for state of curve data validity
-typedef enum eCurveSetValidity
-{
-    CURVEDATA_INVALID    = 0, ///< No current curve set is defined or computed data is invalid
-    CURVEDATA_VALID_SET1 = 1, ///< Curve set 1 is the current one
-    CURVEDATA_VALID_SET2 = 2  ///< Curve set 2 is the current one
-} eCurveSetValidity;
-
-/// Structure containning supervision data
-typedef struct SSupervisionData
-{
-    eSpeedMonitoringType SpeedMonType;        ///< Current speed monitoring type
-    int32_t              lCurveCnt;           ///< Curve counter
-    bool                 bCurvesInProcessing; ///< Indicates if curves are currently in processing
-
-    eCurveSetValidity    CurveSetStatus;                ///< Indicates which curve set is in use and if it contains valid data
-
-    SMovementBound       MinBound;                      ///< Minimum movement bound
-    SMovementBound       MaxBound;                      ///< Maximum movement bound
-    t_speed              dMaxModeSpeed;                 ///< Maximum permitted speed for current mode
-    t_speed              dWModeSpeed;                   ///< Warning speed for current mode
-    t_speed              dSBIModeSpeed;                 ///< SBI speed for current mode
-    t_speed              dEBIModeSpeed;                 ///< EBI speed for current mode
-    eTrainMode           EnterMode;
-
-    t_distance           dOverrideFormerEOA;            ///< Former EOA stored when override selected
+/// Number of curve set slots (can be set at build time, 2 to CURVESET_SLOT_MAX):
+/// the current set, the set being computed and the previous set while a reader still pins it
+#ifndef CURVESET_SLOT_NB
+#define CURVESET_SLOT_NB 3
+#endif // CURVESET_SLOT_NB
 
-    t_distance           dMaxSRDistance;                ///< Maximum distance in SR mode
-    t_speed              dMaxSRSpeed;                   ///< Maximum speed in SR mode
-    t_distance           dSRRefLocation;                ///< Reference location for maximum distance in SR mode
-    bool                 bSRRefLocLocked;               ///< indication of locked reference SR location (cannot be modified for the current calculation)
-    bool                 bNationalValueSRDistance;      ///< Indicates if national value is currently used for maximum distance in SR mode
-    bool                 bNationalValueSRSpeed;         ///< Indicates if national value is currently used for maximum speed in SR mode
+/// Maximum number of curve set slots (number of names in CURVESET_SLOT_NAMES)
+#define CURVESET_SLOT_MAX 8
 
-    t_speed              dMaxShuntingSpeed;             ///< Maximum speed in SH mode, defaulting to national value but that can be modified by mode profile
-    bool                 bNationalValueSHSpeed;         ///< Indicates if national value is currently used for maximum speed in SH mode
-
-    t_distance           dMaxReversingDistance;         ///< Maximum distance in RV mode
-    t_speed              dMaxReversingSpeed;            ///< Maximum speed in RV mode
-    t_distance           dReversingRefLocation;         ///< Reference location for maximum distance in RV mode
-
-    t_distance           dPTRefLocation;                ///< Reference location for maximum distance in PT mode
-
-    bool                 bMaxSTMSpeed;                  ///< Indicates if maximum speed is available for STM mode
-    t_speed              dMaxSTMSpeed;                  ///< Maximum speed in STM mode until STM module switches to DA mode
-
-    STargetList          TargetList;                    ///< List of targets when in curve monitoring
-
-    t_distance           dReleaseAreaStart;             ///< Release start location for release speed monitoring
-    t_speed              dReleaseSpeed;                 ///< Release speed for release speed monitoring
-
-    bool                 bWarningIndication;            ///< Indicates if indication of warning on MMI is required (warning speed is passed)
-    bool                 bOverSpeedInt;                 ///< Indicates if intervention is due to over speed
-    bool                 bIndicationSpeed;              ///< indicates if indication speed is passed
-
-    bool                 bPreIndication;                ///< Indicates if train is after pre-indication point
+#if ( CURVESET_SLOT_NB < 2 ) || ( CURVESET_SLOT_NB > CURVESET_SLOT_MAX )
+#error "CURVESET_SLOT_NB must be 2 to CURVESET_SLOT_MAX"
+#endif
 
-    t_speed              dMRSP;                         ///< Most restrictive speed
+/// Slot index used when no valid curve set is published
+#define CURVESET_NO_SLOT ( -1 )
 
-    t_speed              dIndic_Speed;                  ///< Indication speed
-    t_speed              dPermitted_Speed;              ///< Permitted speed
-    t_speed              dWarn_Speed;                   ///< Warning speed
-    t_speed              dSBI_Speed;                    ///< SBI speed
-    t_speed              dEBI_Speed;                    ///< EBI speed
+/// Names of the curve set slots ("Curve Set <slot + 1>"), each CURVESET_SLOT_NAME_LEN bytes long with the final 0
+#define CURVESET_SLOT_NAMES \
+    "Curve Set 1\0Curve Set 2\0Curve Set 3\0Curve Set 4\0Curve Set 5\0Curve Set 6\0Curve Set 7\0Curve Set 8"
+#define CURVESET_SLOT_NAME_LEN 12
 
-    t_distance           dEOALocation;   ///< EOA not taking in account LX
-    int32_t              lNewStopLocCnt; ///< Counter of stop location (reduction) to apply A3.4
-    t_distance           dStopLocation;  ///< SL not taking in account mode change or route unsuitability
+/// Macro to get the string corresponding to a curve set slot ("None" if not a slot)
+#define STR_CURVESET_SLOT( d ) \
+    ( ( ( ( d ) >= 0 ) && ( ( d ) < CURVESET_SLOT_NB ) ) ? &CURVESET_SLOT_NAMES[ ( d ) * CURVESET_SLOT_NAME_LEN ] : "None" )
 
-    bool                 bReverseMvt;                   ///< Indicates if the train performs a reverse movement
+/// Structure containing one curve set with the track description used to compute it
+typedef struct SCurveSetSlot
+{
+    SIntervCurves Curves;    ///< Supervision curves
+    STrackDesc    TrackDesc; ///< MRSP and gradient track description of the curves
+    uint32_t      ulEpoch;   ///< Publication epoch of the set (0 if never published)
+    int32_t       lPinCount; ///< Number of readers using the set (atomic access only)
+} SCurveSetSlot;
 
-    int32_t              lSBAckRqst;    ///< Counter for request of ack to release SB
-    int32_t              lEBAckRqst;    ///< Counter for request of ack to release EB
+/// Structure containing the published curve sets (see CurveSet_Pin, CurveSet_Unpin)
+typedef struct SCurveSetPublication
+{
+    int32_t       lCurrentSlot;               ///< Index of the current set, CURVESET_NO_SLOT if none (atomic access only)
+    uint32_t      ulEpoch;                    ///< Epoch of the last publication (atomic access only)
+    SCurveSetSlot aSlot[ CURVESET_SLOT_NB ];  ///< Curve set slots
+} SCurveSetPublication;
 
-    bool                 bInNonProtectedLXArea; ///< indicate that the train is in the BCA of a non protected LX
-    uint32_t             ulTunnelStopAreaDist;  ///< Indicates distance to tunnel stopping area ( 0 = inside )
+/// Structure containning supervision data
+typedef struct SSupervisionData
+{
+    /// Block written by the curve computer
+    struct CACHE_ALIGNED
+    {
+        int32_t     lCurveCnt;           ///< Curve counter
+        bool        bCurvesInProcessing; ///< Indicates if curves are currently in processing
+        STargetList TargetList;          ///< List of targets when in curve monitoring
+        t_distance  dReleaseAreaStart;   ///< Release start location for release speed monitoring
+        t_speed     dReleaseSpeed;       ///< Release speed for release speed monitoring
+        t_distance  dEOALocation;        ///< EOA not taking in account LX
+        int32_t     lNewStopLocCnt;      ///< Counter of stop location (reduction) to apply A3.4
+        t_distance  dStopLocation;       ///< SL not taking in account mode change or route unsuitability
+    } Curves;
+
+    /// Block written by the mode manager
+    struct CACHE_ALIGNED
+    {
+        eSpeedMonitoringType SpeedMonType;             ///< Current speed monitoring type
+        SMovementBound       MinBound;                 ///< Minimum movement bound
+        SMovementBound       MaxBound;                 ///< Maximum movement bound
+        t_speed              dMaxModeSpeed;            ///< Maximum permitted speed for current mode
+        t_speed              dWModeSpeed;              ///< Warning speed for current mode
+        t_speed              dSBIModeSpeed;            ///< SBI speed for current mode
+        t_speed              dEBIModeSpeed;            ///< EBI speed for current mode
+        eTrainMode           EnterMode;
+        t_distance           dOverrideFormerEOA;       ///< Former EOA stored when override selected
+        t_distance           dMaxSRDistance;           ///< Maximum distance in SR mode
+        t_speed              dMaxSRSpeed;              ///< Maximum speed in SR mode
+        t_distance           dSRRefLocation;           ///< Reference location for maximum distance in SR mode
+        bool                 bSRRefLocLocked;          ///< indication of locked reference SR location (cannot be modified for the current calculation)
+        bool                 bNationalValueSRDistance; ///< Indicates if national value is currently used for maximum distance in SR mode
+        bool                 bNationalValueSRSpeed;    ///< Indicates if national value is currently used for maximum speed in SR mode
+        t_speed              dMaxShuntingSpeed;        ///< Maximum speed in SH mode, defaulting to national value but that can be modified by mode profile
+        bool                 bNationalValueSHSpeed;    ///< Indicates if national value is currently used for maximum speed in SH mode
+        t_distance           dMaxReversingDistance;    ///< Maximum distance in RV mode
+        t_speed              dMaxReversingSpeed;       ///< Maximum speed in RV mode
+        t_distance           dReversingRefLocation;    ///< Reference location for maximum distance in RV mode
+        t_distance           dPTRefLocation;           ///< Reference location for maximum distance in PT mode
+        bool                 bMaxSTMSpeed;             ///< Indicates if maximum speed is available for STM mode
+        t_speed              dMaxSTMSpeed;             ///< Maximum speed in STM mode until STM module switches to DA mode
+    } Mode;
+
+    /// Block written by the speed controller (once per supervision cycle)
+    struct CACHE_ALIGNED
+    {
+        bool     bWarningIndication;    ///< Indicates if indication of warning on MMI is required (warning speed is passed)
+        bool     bOverSpeedInt;         ///< Indicates if intervention is due to over speed
+        bool     bIndicationSpeed;      ///< indicates if indication speed is passed
+        bool     bPreIndication;        ///< Indicates if train is after pre-indication point
+        t_speed  dMRSP;                 ///< Most restrictive speed
+        t_speed  dIndic_Speed;          ///< Indication speed
+        t_speed  dPermitted_Speed;      ///< Permitted speed
+        t_speed  dWarn_Speed;           ///< Warning speed
+        t_speed  dSBI_Speed;            ///< SBI speed
+        t_speed  dEBI_Speed;            ///< EBI speed
+        bool     bReverseMvt;           ///< Indicates if the train performs a reverse movement
+        int32_t  lSBAckRqst;            ///< Counter for request of ack to release SB
+        int32_t  lEBAckRqst;            ///< Counter for request of ack to release EB
+        bool     bInNonProtectedLXArea; ///< indicate that the train is in the BCA of a non protected LX
+        uint32_t ulTunnelStopAreaDist;  ///< Indicates distance to tunnel stopping area ( 0 = inside )
+    } Ctrl;
 } SSupervisionData;
 
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SSupervisionData, Curves ), "SSupervisionData: curve computer block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SSupervisionData, Mode ), "SSupervisionData: mode manager block not aligned" );
+LAYOUT_ASSERT( IS_CACHE_ALIGNED( SSupervisionData, Ctrl ), "SSupervisionData: speed controller block not aligned" );
+
+/// Table of the shared data blocks, each written by one module thread: _X( type, block, writer ).
+/// The layout report (offset and size of each block) is generated from it at build time (tools/shared_layout.cpp).
+#define SHARED_LAYOUT_TABLE( _X ) \
+    _X( SETCS_IO, Mode, "mode manager" ) \
+    _X( SETCS_IO, Odo, "odometer interface" ) \
+    _X( SETCS_IO, TiuInputs, "train interface manager" ) \
+    _X( SETCS_IO, TiuOutputs, "speed controller" ) \
+    _X( SETCS_IO, Balise, "balise interface" ) \
+    _X( SETCS_IO, Data, "data manager" ) \
+    _X( SETCS_IO, Ctrl, "speed controller" ) \
+    _X( SETCS_IO, Sim, "simulation control" ) \
+    _X( SSupervisionData, Curves, "curve computer" ) \
+    _X( SSupervisionData, Mode, "mode manager" ) \
+    _X( SSupervisionData, Ctrl, "speed controller" )
+
+/// Structure containing a consistent picture of the supervision state, written once per supervision cycle.
+/// Speeds are in km/h and locations in m, as returned by the corresponding CEVC_Sim getters.
+typedef struct SSupervisionSnapshot
+{
+    uint32_t             ulCycle;                 ///< Supervision cycle counter of the snapshot
+    t_time               dTime;                   ///< Time of the snapshot from simulation start (s)
+
+    eLevel               Level;                   ///< Current ETCS level
+    eTrainMode           TrainMode;               ///< Current ETCS mode
+    eEVCStatus           Status;                  ///< Current on-board status
+
+    t_distance           dEstimatedFrontLoc;      ///< Estimated front location (m)
+    t_distance           dMinSafeFrontLoc;        ///< Min safe front location (m)
+    t_distance           dMaxSafeFrontLoc;        ///< Max safe front location (m)
+    double               dTrainSpeed;             ///< Train speed (km/h)
+
+    t_distance           dEoaLocation;            ///< EOA location (m), 0 if not applicable
+    double               dEoaSpeed;               ///< EOA speed (km/h)
+    double               dReleaseSpeed;           ///< Release speed (km/h), 0 if not applicable
+    t_distance           dTargetLocation;         ///< Next target location (m), 0 if not applicable
+    double               dTargetSpeed;            ///< Next target speed (km/h)
+    bool                 bTargetKnown;            ///< Indicates if there is a known target
+
+    double               dMRSP;                   ///< Most restrictive speed (km/h)
+    double               dIndSpeed;               ///< Indication speed (km/h)
+    double               dPermSpeed;              ///< Permitted speed (km/h)
+    double               dWarnSpeed;              ///< Warning speed (km/h)
+    double               dSBrakeSpeed;            ///< SBI speed (km/h)
+    double               dEBrakeSpeed;            ///< EBI speed (km/h)
+
+    eSpeedMonitoringType SpeedMonType;            ///< Speed monitoring type (NONE, CEILING, CURVE)
+    eSpeedMonitoringStatus SpeedMonitStatus;        ///< Speed monitoring status (CSM, PIM, TSM, RSM)
+    eInterventionType    Int_Type;                ///< Type of intervention
+    bool                 bPreIndication;          ///< Indicates if train is after pre-indication point
+    bool                 bEmergencyStop;          ///< Indicates if an emergency stop is required
+
+    int32_t              lGradientValue;          ///< Current gradient value
+    int32_t              lAdhesionFactor;         ///< Current adhesion factor (in %)
+    int32_t              lCurveCnt;               ///< Curve counter
+    uint32_t             ulCurveSetEpoch;         ///< Publication epoch of the curve set used
+
+} SSupervisionSnapshot;
+
+/// Structure containing the supervision snapshot protected by a sequence lock
+/// (ulSequence is odd while the speed controller writes the snapshot)
+typedef struct SSupervisionSnapshotBuffer
+{
+    uint32_t             ulSequence; ///< Sequence counter (atomic access only)
+    SSupervisionSnapshot Snapshot;   ///< Last written snapshot
+} SSupervisionSnapshotBuffer;
+
 /// Macro to get the last LOA distance (position of last target in the target list array)
 #define SUPDATA_LASTLOADISTANCE \
-    ( pShared->ShSupervisionData.TargetList.Target[ pShared->ShSupervisionData.TargetList.lNb - 1 ].dTargetLocation )
+    ( pShared->ShSupervisionData.Curves.TargetList.Target[ pShared->ShSupervisionData.Curves.TargetList.lNb - 1 ].dTargetLocation )
 
 /// Macro to get the last LOA speed (speed of last target in the target list array)
 #define SUPDATA_LASTLOASPEED \
-    ( pShared->ShSupervisionData.TargetList.Target[ pShared->ShSupervisionData.TargetList.lNb - 1 ].dTargetSpeed )
+    ( pShared->ShSupervisionData.Curves.TargetList.Target[ pShared->ShSupervisionData.Curves.TargetList.lNb - 1 ].dTargetSpeed )
 
 /// Macro to get the last LOA indication point (indication point of last target in the target list array)
 #define SUPDATA_LASTLOABRAKEIP \
-    ( pShared->ShSupervisionData.TargetList.Target[ pShared->ShSupervisionData.TargetList.lNb - 1 ].dIndLocation )
+    ( pShared->ShSupervisionData.Curves.TargetList.Target[ pShared->ShSupervisionData.Curves.TargetList.lNb - 1 ].dIndLocation )
 
 /// Macro to get the last LOA pre-indication point (pre-indication point of last target in the target list array)
 #define SUPDATA_LASTLOABRAKEPREIP \
-    ( pShared->ShSupervisionData.TargetList.Target[ pShared->ShSupervisionData.TargetList.lNb - 1 ].dPreIndLocation )
+    ( pShared->ShSupervisionData.Curves.TargetList.Target[ pShared->ShSupervisionData.Curves.TargetList.lNb - 1 ].dPreIndLocation )
 
 /// Macro to get the last LOA brake start position (brake start position of last target in the target list array)
 #define SUPDATA_LASTLOABRAKESTART \
-    ( pShared->ShSupervisionData.TargetList.Target[ pShared->ShSupervisionData.TargetList.lNb - 1 ].dBrakingStart )
+    ( pShared->ShSupervisionData.Curves.TargetList.Target[ pShared->ShSupervisionData.Curves.TargetList.lNb - 1 ].dBrakingStart )
 
 // ===============================    Static data    =========================================================
 
@@ -6066,17 +6619,60 @@ typedef struct SEVCStaticData
 
 // ===============================    Shared data    =========================================================
 
-/// Macro to get pointer on current curve data set (null pointer if no data are available)
+/// Macro to get pointer on the curve data of a pinned slot (null pointer if no slot)
+#define CURVEDATA_SLOT( _slot ) \
+    ( ( ( _slot ) == CURVESET_NO_SLOT ) ? NULL : &pShared->ShCurveSets.aSlot[ _slot ].Curves )
+
+/// Macro to get pointer on the track description of a pinned slot (null pointer if no slot)
+#define TRACKDATA_SLOT( _slot ) \
+    ( ( ( _slot ) == CURVESET_NO_SLOT ) ? NULL : &pShared->ShCurveSets.aSlot[ _slot ].TrackDesc )
+
+/// Macro to get pointer on current curve data set (null pointer if no data are available), curve computer only
 #define CURVEDATA_CURRENT \
-    ( ( pShared->ShSupervisionData.CurveSetStatus == CURVEDATA_INVALID ) ? NULL : ( ( pShared->ShSupervisionData.CurveSetStatus == CURVEDATA_VALID_SET1 ) ? &pShared->ShCurveSet1 : &pShared->ShCurveSet2 ) )
+    CURVEDATA_SLOT( pShared->ShCurveSets.lCurrentSlot )
 
 /// Macro to get string of current curve data set ("none" if no data are available)
 #define CURVEDATA_CURRENT_STR \
-    ( ( pShared->ShSupervisionData.CurveSetStatus == CURVEDATA_INVALID ) ? "None" : ( ( pShared->ShSupervisionData.CurveSetStatus == CURVEDATA_VALID_SET1 ) ? "Curve Set 1" : "Curve Set 2" ) )
+    STR_CURVESET_SLOT( pShared->ShCurveSets.lCurrentSlot )
 
-/// Macro to get pointer on current track description data set (null pointer if no data are available)
+/// Macro to get pointer on current track description data set (null pointer if no data are available), curve computer only
 #define TRACKDATA_CURRENT \
-    ( ( pShared->ShSupervisionData.CurveSetStatus == CURVEDATA_INVALID ) ? NULL : ( ( pShared->ShSupervisionData.CurveSetStatus == CURVEDATA_VALID_SET1 ) ? &pShared->ShTemporaryDataBig.TrackDesc1 : &pShared->ShTemporaryDataBig.TrackDesc2 ) )
+    TRACKDATA_SLOT( pShared->ShCurveSets.lCurrentSlot )
+
+/// Pin the current curve set (lock-free, for readers): the set stays unchanged until CurveSet_Unpin
+/// @return index of the pinned slot, CURVESET_NO_SLOT if no curve set is published
+static inline int32_t CurveSet_Pin( SCurveSetPublication* pPub )
+{
+    int32_t lSlot;
+
+    for( ;; )
+    {
+        lSlot = __atomic_load_n( &pPub->lCurrentSlot, __ATOMIC_SEQ_CST );
+        if( lSlot == CURVESET_NO_SLOT )
+        {
+            return CURVESET_NO_SLOT;
+        }
+
+        __atomic_add_fetch( &pPub->aSlot[ lSlot ].lPinCount, 1, __ATOMIC_SEQ_CST );
+
+        // still current after pinning: the writer cannot reserve this slot any more
+        if( __atomic_load_n( &pPub->lCurrentSlot, __ATOMIC_SEQ_CST ) == lSlot )
+        {
+            return lSlot;
+        }
+
+        __atomic_sub_fetch( &pPub->aSlot[ lSlot ].lPinCount, 1, __ATOMIC_SEQ_CST );
+    }
+}
+
+/// Release a curve set pinned with CurveSet_Pin
+static inline void CurveSet_Unpin( SCurveSetPublication* pPub, int32_t lSlot )
+{
+    if( lSlot != CURVESET_NO_SLOT )
+    {
+        __atomic_sub_fetch( &pPub->aSlot[ lSlot ].lPinCount, 1, __ATOMIC_SEQ_CST );
+    }
+}
 
 /// Structure containing pointer to structures stored in shared memory
 typedef struct SShared_data
@@ -6084,10 +6680,10 @@ typedef struct SShared_data
     SETCS_IO          ETCS_IO;                  ///< Pointer to structure containing the main EVC data
     SConfig           Config;                   ///< Pointer to structure containing the EVC configuration
 
-    SIntervCurves     ShCurveSet1;              ///< Pointer to first  supervision curve set (can be used while second set is being computed)
-    SIntervCurves     ShCurveSet2;              ///< Pointer to second supervision curve set (can be used while first  set is being computed)
+    SCurveSetPublication ShCurveSets;           ///< Published supervision curve sets
 
     SSupervisionData  ShSupervisionData;        ///< Pointer to structure containing supervision data
+    SSupervisionSnapshotBuffer ShSnapshot;      ///< Supervision snapshot for external readers
 
     STemporaryDataBig ShTemporaryDataBig;       ///< Pointer to structure containing all temporary data
 
@@ -51,6 +51,7 @@ class CDMI_com;
 class CJru_com;
 class COdo_com;
 class CRadio_com;
+class CEvc_metrics;
 
 /*************************************************************************************************
  *  Typedefs and structure declarations
@@ -128,6 +129,14 @@ typedef enum
     TIU_RQST_TRACTION_OFF
 } t_TIUREQUEST;
 
+#ifndef DMI_MAX_ICONS
+#define DMI_MAX_ICONS    64 ///< Number of icons reserved at construction (more icons are stored, with an allocation)
+#endif
+
+#ifndef DMI_MAX_TEXT_MSG
+#define DMI_MAX_TEXT_MSG 64 ///< Number of text messages reserved at construction (more messages are stored, with an allocation)
+#endif
+
 typedef struct SDmiComTextMsg
 {
     uint32_t     ulId;
@@ -249,6 +258,21 @@ public:
                                        eConfigData eConfig ///< [in] flag to identify the configuration
                                        );
 
+    /// Set parameters of the binary trace used instead of the text logs when CFG_BINARY_TRACE is set (before SIM_Init)
+    /// @return 0 on success, -1 on failure
+    int32_t SIM_SetBinaryTraceParameters( const char* szFileName, ///< [in] binary trace file name
+                                          uint32_t ulRingSize,    ///< [in] size of the ring of each module (bytes, power of 2, 0 for default)
+                                          int32_t lFlushPeriod_ms ///< [in] period of the flush of the rings to the file (ms)
+                                          );
+
+    /// Set parameters of the recording of module activity in Chrome trace event format (JSON),
+    /// done when CFG_RECORD_CHROME_TRACE is set (before SIM_Init)
+    /// @return 0 on success, -1 on failure
+    int32_t SIM_SetChromeTraceParameters( const char* szFileName,  ///< [in] JSON file name
+                                          uint32_t ulCategoryMask, ///< [in] recorded categories (eChromeTraceCategory bits)
+                                          uint32_t ulMaxEvents     ///< [in] maximum number of events kept in memory (oldest are dropped, 0 for no limit)
+                                          );
+
     // --------------------------------------------------------------
     // METHODS TO CONTROL EVC SIMULATION
     // --------------------------------------------------------------
@@ -258,6 +282,12 @@ public:
     int32_t SIM_Init( uint32_t ulLogId ///< [in] key used as prefix for log files
                       );
 
+    /// Set the CPU of a module thread in real-time mode (CFG_REALTIME_MODE), before SIM_Start_processes
+    /// @return 0 on success, -1 if the module or the CPU is not valid
+    int32_t SIM_SetModuleCpuAffinity( eAddressId ModuleId, ///< [in] module (ADDR_EVCCTRL_ID for the EVC controller)
+                                      int32_t lCpu         ///< [in] CPU number (-1 for no pinning)
+                                      );
+
     /// Start the EVC simulator modules
     /// @return 0 on success
     int32_t SIM_Start_processes( void );
@@ -266,15 +296,106 @@ public:
     /// @return 0 on success
     int32_t SIM_Run( void );
 
+    /// Advance the simulated time when CFG_STEP_MODE is set (after SIM_Run): the module cycles due in the interval
+    /// are run and finished when the call returns (no timer, no sleep)
+    /// @return number of module cycles run, -1 if CFG_STEP_MODE is not set or the simulation is not running
+    int32_t SIM_Step( int32_t lDuration_ms ///< [in] duration to simulate (ms)
+                      );
+
     /// Stop the EVC simulation
     /// @return 0 on success
     int32_t SIM_Stop( void );
 
+    /// Return a started simulator to its state after Init, to run another scenario (module threads and
+    /// communications are kept, data, mailboxes, logs and JRU file are reset). Call SIM_Run to start again.
+    /// @return 0 on success, -1 if the simulator is not started
+    int32_t SIM_Reset( uint32_t ulLogId ///< [in] key used as prefix for the new log files
+                       );
+
     /// check if DMI is connected and version of communication protocol is compatible
     /// it should be called after Start_processes
     /// @return true is communication with DMI is working
     bool SIM_IsDMIReady( void );
 
+    /// Get the statistics of the mailbox of a module (one lane per eMsgPriority)
+    /// @return true on success, false if the module has no mailbox
+    bool SIM_GetMailboxStats( eAddressId ModuleId,   ///< [in]  module owning the mailbox
+                              SMailboxStats* pStats, ///< [out] statistics of each lane
+                              bool bReset = false    ///< [in]  reset the maximum values and counters after reading
+                              );
+
+    /// Get the cycle statistics of the module threads (modules and EVC controller)
+    /// @return number of modules written in the array
+    int32_t SIM_GetModuleCycleStats( SModuleCycleStats* aStats, ///< [out] statistics of each module
+                                     int32_t lMaxNb,            ///< [in]  number of elements of the array
+                                     bool bReset = false        ///< [in]  request the modules to clear the histograms at their next cycle
+                                     );
+
+    /// Get the latency statistics of the internal messages (queueing and processing time)
+    /// @return number of groups written in the array
+    int32_t SIM_GetMsgLatencyStats( eMsgLatencyGroup Group,    ///< [in]  grouping by application code or by sender / receiver pair
+                                    SMsgLatencyStats* aStats,  ///< [out] statistics of each group
+                                    int32_t lMaxNb,            ///< [in]  number of elements of the array
+                                    bool bReset = false        ///< [in]  clear the histograms after reading
+                                    );
+
+    /// Get the latency statistics from each external input to the resulting TIU output transitions
+    /// @return number of inputs written in the array
+    int32_t SIM_GetInputLatencyStats( SInputLatencyStats* aStats, ///< [out] statistics of each external input
+                                      int32_t lMaxNb,             ///< [in]  number of elements of the array
+                                      bool bReset = false         ///< [in]  clear the histograms after reading
+                                      );
+
+    /// Set the maximum reaction time of a brake intervention (violations are traced and recorded in JRU and CSV files)
+    /// @return 0 on success, -1 if the type is not valid
+    int32_t SIM_SetReactionTimeBound( eBrakeReaction Type, ///< [in]  monitored intervention
+                                      t_time dBound        ///< [in]  maximum reaction time (s, 0 to disable the check)
+                                      );
+
+    /// Get the reaction time statistics of the brake interventions (one element per eBrakeReaction)
+    /// @return number of elements written in the array
+    int32_t SIM_GetReactionTimeStats( SReactionTimeStats* aStats, ///< [out] statistics of each intervention
+                                      int32_t lMaxNb,             ///< [in]  number of elements of the array
+                                      bool bReset = false         ///< [in]  clear the statistics after reading
+                                      );
+
+    /// Get the counters of resources used by the EVC since Init
+    void SIM_GetResourceUsage( SResourceUsage* pUsage ///< [out] resource counters
+                               );
+
+    /// Get the duration of the startup phases
+    void SIM_GetStartupTiming( SStartupTiming* pTiming ///< [out] duration of each phase
+                               );
+
+    /// Get the status of the real-time execution: memory locking, scheduling, page faults and deadline misses
+    void SIM_GetRealTimeStats( SRealTimeStats* pStats ///< [out] real-time status
+                               );
+
+    // --------------------------------------------------------------
+    // METRICS EXPORT
+    // --------------------------------------------------------------
+
+    /// Start the export of the metrics for long runs. The metrics are collected from the statistics above
+    /// (mailbox depths, messages per code, cycle and latency histograms, reaction times, resource usage
+    /// with the size and resident memory of each structure of the shared data)
+    /// and exported in Prometheus text format:
+    /// - on a local Unix socket (each connection receives the current metrics), and/or
+    /// - appended periodically to a file (one block per period, with a timestamp).
+    /// @return 0 on success, -1 if the socket or the file cannot be opened
+    int32_t SIM_StartMetricsExport( const char* szSocketPath,   ///< [in] path of the Unix socket (NULL for no socket)
+                                    const char* szDumpFileName, ///< [in] name of the dump file (NULL for no file)
+                                    int32_t lDumpPeriod_s       ///< [in] period of the dump (s)
+                                    );
+
+    /// Stop the export of the metrics (the socket is closed, a last block is written in the dump file)
+    void SIM_StopMetricsExport( void );
+
+    /// Get the current metrics in Prometheus text format
+    /// @return length of the whole text (the text is truncated if it is not lower than ulMaxLength)
+    uint32_t SIM_GetMetricsText( char* szText,        ///< [out] metrics text (null terminated)
+                                 uint32_t ulMaxLength ///< [in]  size of the buffer
+                                 );
+
     // --------------------------------------------------------------
     // METHODS TO CONFIFURE EVC SIMULATION (STARTING CONDITIONS)
     // --------------------------------------------------------------
@@ -484,6 +605,11 @@ public:
     /// Get current speed monitoring status (CSM,PIM,TSM,RSM,UNKNOWN)
     eSpeedMonitoringStatus SIM_GetSpeedMonitoringStatus( void );
 
+    /// Get a consistent snapshot of the supervision data (written once per supervision cycle),
+    /// replacing successive calls of the getters above
+    void SIM_GetSupervisionSnapshot( SSupervisionSnapshot* pSnapshot ///< [out] copy of the last snapshot
+                                     );
+
     /// Get next target location
     /// @return target location (m) or 0 if not applicable
     t_distance SIM_GetTargetLocation( void );
@@ -500,6 +626,12 @@ public:
     /// @return session status (RELEASED, INITIALISED, ESTABLISHED, TERMINATED)
     eRadSessionState SIM_GetSessionStatus( int32_t lEquipmentIdx );
 
+    /// Get the status of all radio equipments in one call
+    /// @return number of equipments written in the array
+    int32_t SIM_GetRadioStatus( SRadioEquipmentStatus* aStatus, ///< [out] status of each equipment (index is the equipment ID)
+                                int32_t lMaxNb ///< [in]  number of elements of the array
+                                );
+
     /// Get current adhesion factor (70 or 100)
     int32_t SIM_GetAdhesionFactor( void );
 
@@ -591,6 +723,25 @@ public:
     /// @return EVC TIU
     STxTiuData ODO_getEvcTiu();
 
+    /// Register a function called on each TIU output transition (in the thread of the train interface manager,
+    /// it must be short and non blocking)
+    void ODO_SetTiuEventCallback( t_TiuEventCallback pCallback, ///< [in] function to call (NULL to unregister)
+                                  void * pContext               ///< [in] user pointer given to the function
+                                  );
+
+    /// Get the file descriptor readable when TIU output events are pending
+    /// (only to be watched, it is reset by ODO_ReadTiuEvent when the last pending event has been read)
+    /// @return file descriptor, -1 on error
+    int32_t ODO_GetTiuEventFd( void );
+
+    /// Read the next pending TIU output event (ODO_getEvcTiu is updated with the event data).
+    /// Call it until it returns 0: the event descriptor (ODO_GetTiuEventFd) is then reset.
+    /// @return -1 on error
+    /// @return  0 when there is no pending event (event descriptor reset)
+    /// @return  1 when an event has been read
+    int32_t ODO_ReadTiuEvent( STxTiuEvent * pEvent ///< [out] TIU output transition
+                              );
+
     /// Get TIU data from EVC
     /// @return -1 on error
     /// @return  0 when there is no TIU change
@@ -633,6 +784,12 @@ public:
     /// @return 0 on success
     int32_t ODO_SetBrakePressure( double dBrakePressure ); ///< [in] pressure
 
+    /// Send the changed fields of the train TIU to EVC in one message (applied in the same cycle)
+    /// @return 0 on success
+    int32_t ODO_SetTiuDataDelta( const SRxTiuData * pData, ///< [in] train TIU (only the fields of the mask are used)
+                                 uint32_t ulChangedMask    ///< [in] fields to apply (RX_TIU_xxx)
+                                 );
+
     /// Send TIU drive request
     /// @return 0 on success
     int32_t ODO_Send_TIUDriver_request( t_TIUREQUEST Request );
@@ -641,6 +798,24 @@ public:
      *  RAD functions
      *************************************************************************************************/
 
+    /// Get the number of radio equipments (lNbEquipment given to the CRadio_com constructor, 2 by default)
+    /// @return: number of equipments (IDs are 0 to number - 1)
+    int32_t RAD_GetEquipmentNb( void );
+
+    /// Send a radio message to EVC via the indicated radio equipment
+    /// @return: 0 if message is sent correctly
+    int32_t RAD_Send_Radio_Msg( int32_t iMsgLength, ///< [in]: Message length in bytes
+                                uint8_t * uszMsg, ///< [in]: Message (binary stream)
+                                int32_t iEquipmentID ///< [in]: radio equipement ID (0 to RAD_GetEquipmentNb() - 1)
+                                );
+
+    /// Receive a radio message from the indicated EVC radio equipment
+    /// @return Size of the received message in bytes (0 if there is no message)
+    int32_t RAD_Receive_Radio_Msg( uint8_t * uszMsg, ///< [out] : pointer on the buffer to store the received data
+                                   int32_t iMaxLength, ///< [in]  : maximum size of the buffer to store the received data
+                                   int32_t iEquipmentID ///< [in]  : equipment ID (0 to RAD_GetEquipmentNb() - 1)
+                                   );
+
     /// Send a radio message to EVC via the first radio equipment
     /// @return: 0 if message is sent correctly
     int32_t RAD_Send_Radio_Msg1( int32_t iMsgLength, ///< [in]: Message length in bytes
@@ -667,6 +842,35 @@ public:
                                     bool bWait ///< [in]  : (DEPRECATED)qualificator indicating if the function should block until data are received
                                     );
 
+    /// Receive a radio message, blocking until a message is received or the timeout elapses
+    /// @return Size of the received message in bytes (0 if there is no message at timeout, -1 on error)
+    int32_t RAD_Receive_Radio_Msg_Wait( uint8_t * uszMsg, ///< [out] : pointer on the buffer to store the received data
+                                        int32_t iMaxLength, ///< [in]  : maximum size of the buffer to store the received data
+                                        int32_t iTimeoutMs, ///< [in]  : maximum waiting time in ms (0: no wait, RAD_WAIT_INFINITE: no limit)
+                                        int32_t iEquipmentID, ///< [in]  : equipment ID (0 to RAD_GetEquipmentNb() - 1 or RAD_ANY_EQUIPMENT)
+                                        int32_t* piRxEquipmentID ///< [out] : equipment ID of the received message (can be NULL)
+                                        );
+
+    /// Get the event file descriptor (eventfd) readable when a message is available on any radio equipment
+    /// @return file descriptor, -1 if not available
+    int32_t RAD_GetRxEventFd( void );
+
+    /// Receive all the pending radio messages of the indicated equipment(s) in one call
+    /// @return Number of received messages (0 if there is no message, -1 on error)
+    int32_t RAD_Receive_Radio_Msgs( uint8_t* uszArena, ///< [out] : buffer to store the data of the received messages
+                                    int32_t iArenaSize, ///< [in]  : size of the buffer in bytes
+                                    SRadioMsgDesc* pDesc, ///< [out] : array of message descriptors
+                                    int32_t iMaxMsgNb, ///< [in]  : number of elements of the descriptor array
+                                    int32_t iEquipmentID ///< [in]  : equipment ID (0 to RAD_GetEquipmentNb() - 1 or RAD_ANY_EQUIPMENT)
+                                    );
+
+    /// Send several radio messages to EVC in one call
+    /// @return Number of messages sent
+    int32_t RAD_Send_Radio_Msgs( const uint8_t* uszArena, ///< [in]  : buffer containing the data of the messages
+                                 const SRadioMsgDesc* pDesc, ///< [in]  : array of message descriptors
+                                 int32_t iMsgNb ///< [in]  : number of messages
+                                 );
+
     /*************************************************************************************************
      *  DMI functions
      *************************************************************************************************/
@@ -726,9 +930,23 @@ public:
     /// get list of displayed icons
     void DMI_getIconList( std::vector< SDmiComIcon > &icons ) const;
 
+    /// get list of displayed icons without allocation (for cyclic calls).
+    /// At most lMaxNb icons are copied, the next ones are not returned.
+    /// @return number of icons copied in the array
+    int32_t DMI_getIconList( SDmiComIcon* aIcons, ///< [out] displayed icons
+                             int32_t lMaxNb       ///< [in]  number of elements of the array (DMI_MAX_ICONS)
+                             ) const;
+
     /// get list of displayed text messages
     void DMI_getTextMessageList( std::vector< SDmiComTextMsg > &texts ) const;
 
+    /// get list of displayed text messages without allocation (for cyclic calls).
+    /// At most lMaxNb messages are copied, the next ones are not returned.
+    /// @return number of messages copied in the array
+    int32_t DMI_getTextMessageList( SDmiComTextMsg* aTexts, ///< [out] displayed text messages
+                                    int32_t lMaxNb          ///< [in]  number of elements of the array (DMI_MAX_TEXT_MSG)
+                                    ) const;
+
     /// get list of active levels
     void DMI_getLevelList( std::vector< SLevel > &levels );
 
@@ -753,5 +971,6 @@ private:
     CJru_com*    m_pJru_com;
     COdo_com*    m_pOdo_com;
     CRadio_com*  m_pRad_com;
+    CEvc_metrics* m_pMetrics; ///< Metrics registry and export thread (created by SIM_StartMetricsExport)
 };
 #endif // ifndef _EVC_COM_H
@@ -0,0 +1,90 @@
+/*****************************************************************
+Copyright  2014 - European Rail Software Applications (ERSA)
+                   5 rue Maurice Blin
+                   67500 HAGUENAU
+                   FRANCE
+                   http://www.ersa-france.com
+
+Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)
+
+Licensed under the EUPL Version 1.1.
+
+You may not use this work except in compliance with the License.
+You may obtain a copy of the License at:
+http://ec.europa.eu/idabc/eupl.html
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+either express or implied. See the License for the specific
+language governing permissions and limitations under the License.
+*****************************************************************/
+
+
+// *************************************************************************************************
+
+/// @file   evc_pool.h
+/// @brief  Declaration of the pool of started simulators, reused between scenarios.
+/// Project     : EVC Simulator -
+/// Module      : EVC -
+// *************************************************************************************************
+
+#ifndef _EVC_POOL_H
+#define _EVC_POOL_H
+
+/*************************************************************************************************
+ *  Includes
+ *************************************************************************************************/
+#include "evc_com.h"
+
+/*************************************************************************************************
+ *  Class declarations
+ *************************************************************************************************/
+
+/// Pool of simulators ready to run a scenario.
+/// The simulators are created, initialised and started (SIM_Init, SIM_Start_processes) once.
+/// A released simulator is reset (SIM_Reset) by a background thread before it is given again,
+/// so Acquire returns immediately as long as a simulator is free.
+
+class
+
+#ifdef DLL_EXPORT
+DLL_EXPORT
+#endif
+
+CEvc_pool
+{
+public:
+
+    /// Constructor: the simulators are created and started
+    explicit CEvc_pool( int32_t lNbInstances,                  ///< [in] number of simulators
+                        uint32_t ulFirstLogId,                 ///< [in] log key of the first simulator (next ones use the next keys)
+                        const eConfigData* aConfig = NULL,     ///< [in] configurations to set on each simulator (SIM_Modify_EVC_Configuration)
+                        int32_t lNbConfig = 0                  ///< [in] number of configurations
+                        );
+
+    /// Destructor: the simulators are stopped and deleted
+    virtual ~CEvc_pool();
+
+    /// Get a free simulator, in its state after Init (call SIM_Run to start the scenario)
+    /// @return simulator, NULL if none is free before the timeout
+    CEvc_com* Acquire( int32_t iTimeoutMs = -1 ///< [in] maximum waiting time (ms, -1 to wait until one is free)
+                       );
+
+    /// Give back a simulator got with Acquire (it is reset in background)
+    void Release( CEvc_com* pEvc ///< [in] simulator to give back
+                  );
+
+    /// Get the number of simulators of the pool
+    /// @return number of simulators
+    int32_t GetSize( void ) const;
+
+    /// Get the number of simulators ready to be acquired
+    /// @return number of free simulators
+    int32_t GetFreeNb( void ) const;
+
+private:
+
+    void* m_pPool; ///< Simulators, free list and reset thread
+};
+#endif // ifndef _EVC_POOL_H
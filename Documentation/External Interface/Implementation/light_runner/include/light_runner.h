@@ -27,6 +27,7 @@ language governing permissions and limitations under the License.
 #include <QDebug>
 
 class CEvc_com;
+class QSocketNotifier;
 
 namespace Ui {
 class LightRunner;
@@ -47,13 +48,17 @@ protected:
 private:
     Ui::LightRunner *ui;
     CEvc_com* m_pEvc_com;
+    QSocketNotifier* m_pTIUNotifier;
     int m_TIUTimerId;
     int m_ODOTimerId;
     double m_Position;
 
+    void showreactiontime();
+
 private slots:
     void on_m_StartEVCButton_clicked();
     void mainswitchon();
+    void tiuevent();
 };
 
 #endif // LIGHT_RUNNER_H
@@ -25,26 +25,8 @@
 #                                                                  #
 ####################################################################
 
-# Suffix definition
-CONFIG(debug, debug|release) {
-    DEFINES -= NDEBUG
-    DEFINES *= DEBUG
-    DEFINES *= _DEBUG
-    DEFINES *= __DEBUG__
-
-    SUFFIX_STR = d
-}
-
-CONFIG(release, debug|release) {
-    DEFINES *= NDEBUG
-    DEFINES -= DEBUG
-    DEFINES -= _DEBUG
-    DEFINES -= __DEBUG__
-}
+include( light_runner.pri )
 
-# Intermediate output dir
-OBJECTS_DIR         =   .out$${SUFFIX_STR}
-MOC_DIR             =   $${OBJECTS_DIR}/moc
 RCC_DIR             =   $${OBJECTS_DIR}/rcc
 UI_DIR              =   $${OBJECTS_DIR}/ui
 
@@ -52,35 +34,33 @@ TARGET              =   light_runner$${SUFFIX_STR}
 
 # Project configuration
 TEMPLATE            =   app
-DESTDIR             =   bin
 
-CONFIG              *=  qt thread
 QT                  *=  core gui sql
 
 greaterThan(QT_MAJOR_VERSION, 4) {
-    QT              *=  widgets testlib
-} else {
-    CONFIG          *=  qtestlib
+    QT              *=  widgets
 }
 
-INCLUDEPATH         *=  include                                                 \
-                        ../evc/evc_com/include                                  \
-                        ../evc/eurocab/include
-
 HEADERS             =   include/light_runner.h
 
 
-SOURCES             =   src/light_runner.cpp                                    
+SOURCES             =   src/light_runner.cpp
 
-FORMS               =   ui/light_runner.ui                                        
+FORMS               =   ui/light_runner.ui
 
 
-LIBS                *=  -L../lib -levc_com$${SUFFIX_STR}
+# Layout report of the shared data blocks (offset and size), generated at build time in bin/shared_layout.txt
+shared_layout.target    =   $${DESTDIR}/shared_layout.txt
+shared_layout.depends   =   $$PWD/tools/shared_layout.cpp $$PWD/include/etcs_types.h
+shared_layout.commands  =   $(CHK_DIR_EXISTS) $${DESTDIR} || $(MKDIR) $${DESTDIR}                                   $$escape_expand(\\n\\t)\
+                            $(CXX) $(CXXFLAGS) $(INCPATH) -o $${DESTDIR}/shared_layout $$PWD/tools/shared_layout.cpp    $$escape_expand(\\n\\t)\
+                            $${DESTDIR}/shared_layout > $${DESTDIR}/shared_layout.txt
 
+QMAKE_EXTRA_TARGETS *=  shared_layout
+PRE_TARGETDEPS      *=  $${DESTDIR}/shared_layout.txt
 
-# rpath should point to the shared lib directory (relative to the binary)
-QMAKE_LFLAGS    *=  -Wl,-rpath,../lib                                       \
-                    -Wl,-rpath,\'\$$ORIGIN/../../lib\'
 
-PRE_TARGETDEPS  *=  ../lib/libevc_com$${SUFFIX_STR}.so
+# Tests (make check), built in tests/ and run against the same libevc_com
+check.commands      =   cd $$PWD/tests && $(QMAKE) tst_cyclealloc.pro && $(MAKE) check
 
+QMAKE_EXTRA_TARGETS *=  check
@@ -22,6 +22,8 @@ language governing permissions and limitations under the License.
 
 #include <QApplication>
 #include <QTimer>
+#include <QSocketNotifier>
+#include <QStatusBar>
 
 #include "light_runner.h"
 #include "ui_light_runner.h"
@@ -33,6 +35,7 @@ LightRunner::LightRunner(QWidget *parent) :
     QMainWindow(parent),
     ui(new Ui::LightRunner),
     m_pEvc_com( NULL ),
+    m_pTIUNotifier( NULL ),
     m_TIUTimerId(0),
     m_ODOTimerId(0),
     m_Position(0.0)
@@ -42,6 +45,8 @@ LightRunner::LightRunner(QWidget *parent) :
 
 LightRunner::~LightRunner()
 {
+    delete m_pTIUNotifier;
+
     if( 0 != m_TIUTimerId )
     {
         killTimer( m_TIUTimerId );
@@ -74,16 +79,27 @@ void LightRunner::on_m_StartEVCButton_clicked()
 
 void LightRunner::mainswitchon()
 {
-    m_pEvc_com->ODO_Send_TIUDriver_request( TIU_RQST_MAINSWITCH_ON );
-    m_pEvc_com->ODO_Send_TIUDriver_request( TIU_RQST_CABIN_A );
-
-    // Start timers
-    if( 0 != m_TIUTimerId )
+    // Power on and open cabin A in one message
+    struct SRxTiuData tiu = m_pEvc_com->ODO_getTrainTiu();
+    tiu.bMainSwitchOn = true;
+    tiu.ActiveCabin   = CABIN_A;
+    m_pEvc_com->ODO_SetTiuDataDelta( &tiu, RX_TIU_MAIN_SWITCH | RX_TIU_CABIN );
+
+    // Follow TIU outputs as soon as they change (polling is only used when no event descriptor is available)
+    if( NULL == m_pTIUNotifier )
     {
-        killTimer( m_TIUTimerId );
-    }
+        int fd = m_pEvc_com->ODO_GetTiuEventFd();
 
-    m_TIUTimerId = startTimer( 100 );
+        if( fd >= 0 )
+        {
+            m_pTIUNotifier = new QSocketNotifier( fd, QSocketNotifier::Read, this );
+            connect( m_pTIUNotifier, SIGNAL(activated(int)), this, SLOT(tiuevent()) );
+        }
+        else if( 0 == m_TIUTimerId )
+        {
+            m_TIUTimerId = startTimer( 100 );
+        }
+    }
 
     if( 0 != m_ODOTimerId )
     {
@@ -93,6 +109,43 @@ void LightRunner::mainswitchon()
     m_ODOTimerId = startTimer( 50 );
 }
 
+void LightRunner::tiuevent()
+{
+    struct STxTiuEvent event;
+    bool bEBChanged = false;
+
+    // read all the pending transitions (the event descriptor is reset by the last read)
+    while( 1 == m_pEvc_com->ODO_ReadTiuEvent( &event ) )
+    {
+        bEBChanged = bEBChanged || ( event.ulChangedMask & TX_TIU_EB );
+
+        ui->m_EBButton->setChecked( event.TiuData.bEB_App );
+        ui->m_SBButton->setChecked( event.TiuData.bSB_App );
+    }
+
+    if( bEBChanged )
+    {
+        showreactiontime();
+    }
+}
+
+void LightRunner::showreactiontime()
+{
+    SReactionTimeStats stats[ BRAKE_REACTION_NB ];
+    int32_t nb = m_pEvc_com->SIM_GetReactionTimeStats( stats, BRAKE_REACTION_NB );
+
+    for( int32_t i = 0; i < nb; i++ )
+    {
+        if( ( BRAKE_REACTION_EB == stats[ i ].Type ) && ( stats[ i ].ulInterventionCnt > 0 ) )
+        {
+            statusBar()->showMessage( QString( "EB reaction time: max %1 us, %2 interventions, %3 above bound" )
+                                      .arg( stats[ i ].ReactionTime.ulMax_us )
+                                      .arg( stats[ i ].ulInterventionCnt )
+                                      .arg( stats[ i ].ulViolationCnt ) );
+        }
+    }
+}
+
 void LightRunner::timerEvent( QTimerEvent* event )
 {
     if( event->timerId() == m_TIUTimerId )
@@ -102,11 +155,6 @@ void LightRunner::timerEvent( QTimerEvent* event )
             m_pEvc_com->ODO_RefreshTIUData();
             struct STxTiuData tiu = m_pEvc_com->ODO_getEvcTiu();
 
-            if( tiu.bEB_App )
-            {
-                qDebug() << tiu.bEB_App;
-            }
-
             ui->m_EBButton->setChecked( tiu.bEB_App );
             ui->m_SBButton->setChecked( tiu.bSB_App );
         }
@@ -0,0 +1,362 @@
+/*****************************************************************
+Copyright © 2014 - European Rail Software Applications (ERSA)
+                   5 rue Maurice Blin
+                   67500 HAGUENAU
+                   FRANCE
+                   http://www.ersa-france.com
+
+Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)
+
+Licensed under the EUPL Version 1.1.
+
+You may not use this work except in compliance with the License.
+You may obtain a copy of the License at:
+http://ec.europa.eu/idabc/eupl.html
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+either express or implied. See the License for the specific
+language governing permissions and limitations under the License.
+*****************************************************************/
+
+//*************************************************************************************************
+/// @file   tst_cyclealloc.cpp
+/// @brief  Check that the periodic path (odometry in, speed monitoring, TIU out, DMI dynamic packet)
+///         does no heap allocation once the EVC is running.
+/// All the allocation entry points of the process are replaced (malloc family, aligned allocations,
+/// operator new), so the allocations of the EVC threads are counted too. The EVC runs in CFG_STEP_MODE:
+/// each cycle is one SIM_Step, the test does not depend on timers or on the host load.
+//*************************************************************************************************
+
+#include <QtTest>
+
+#include <errno.h>
+#include <stdlib.h>
+#include <new>
+
+#include "evc_com.h"
+#include "etcs_config.h"
+
+/// Number of cycles run before counting (EVC start, first curves, first DMI packets)
+#define WARMUP_CYCLE_NB     100
+
+/// Number of counted cycles
+#define TEST_CYCLE_NB       400
+
+/// Simulated duration of a cycle (period of the light_runner odometry)
+#define CYCLE_PERIOD_ms     50
+
+/// Simulated duration of the EVC start and of the power on
+#define STARTUP_ms          1000
+
+/// Train speed during the test (m/s)
+#define TEST_SPEED_m_s      5.0
+
+//-------------------------------------------------------------------------------------------------
+//                                allocation counter
+//-------------------------------------------------------------------------------------------------
+
+extern "C" void* __libc_malloc( size_t size );
+extern "C" void* __libc_calloc( size_t nmemb, size_t size );
+extern "C" void* __libc_realloc( void* ptr, size_t size );
+extern "C" void* __libc_memalign( size_t alignment, size_t size );
+extern "C" void* __libc_valloc( size_t size );
+extern "C" void* __libc_pvalloc( size_t size );
+extern "C" void  __libc_free( void* ptr );
+
+static volatile bool        g_bCountAlloc = false;  ///< Allocations are counted when set
+static volatile uint32_t    g_ulAllocCnt  = 0;      ///< Number of allocations while g_bCountAlloc is set
+
+static inline void CountAlloc( void )
+{
+    if( g_bCountAlloc )
+    {
+        __sync_fetch_and_add( &g_ulAllocCnt, 1 );
+    }
+}
+
+extern "C" void* malloc( size_t size )
+{
+    CountAlloc();
+    return __libc_malloc( size );
+}
+
+extern "C" void* calloc( size_t nmemb, size_t size )
+{
+    CountAlloc();
+    return __libc_calloc( nmemb, size );
+}
+
+extern "C" void* realloc( void* ptr, size_t size )
+{
+    CountAlloc();
+    return __libc_realloc( ptr, size );
+}
+
+extern "C" void* memalign( size_t alignment, size_t size )
+{
+    CountAlloc();
+    return __libc_memalign( alignment, size );
+}
+
+extern "C" void* aligned_alloc( size_t alignment, size_t size )
+{
+    CountAlloc();
+    return __libc_memalign( alignment, size );
+}
+
+extern "C" int posix_memalign( void** pptr, size_t alignment, size_t size )
+{
+    void* ptr;
+
+    CountAlloc();
+    if( ( alignment % sizeof( void* ) ) != 0 || ( alignment & ( alignment - 1 ) ) != 0 )
+    {
+        return EINVAL;
+    }
+
+    ptr = __libc_memalign( alignment, size );
+    if( NULL == ptr )
+    {
+        return ENOMEM;
+    }
+
+    *pptr = ptr;
+    return 0;
+}
+
+extern "C" void* valloc( size_t size )
+{
+    CountAlloc();
+    return __libc_valloc( size );
+}
+
+extern "C" void* pvalloc( size_t size )
+{
+    CountAlloc();
+    return __libc_pvalloc( size );
+}
+
+extern "C" void free( void* ptr )
+{
+    __libc_free( ptr );
+}
+
+void* operator new( size_t size ) _GLIBCXX_THROW( std::bad_alloc )
+{
+    CountAlloc();
+    void* ptr = __libc_malloc( size ? size : 1 );
+
+    if( NULL == ptr )
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[]( size_t size ) _GLIBCXX_THROW( std::bad_alloc )
+{
+    return operator new( size );
+}
+
+void* operator new( size_t size, const std::nothrow_t& ) _GLIBCXX_USE_NOEXCEPT
+{
+    CountAlloc();
+    return __libc_malloc( size ? size : 1 );
+}
+
+void* operator new[]( size_t size, const std::nothrow_t& ) _GLIBCXX_USE_NOEXCEPT
+{
+    return operator new( size, std::nothrow );
+}
+
+void operator delete( void* ptr ) _GLIBCXX_USE_NOEXCEPT
+{
+    __libc_free( ptr );
+}
+
+void operator delete[]( void* ptr ) _GLIBCXX_USE_NOEXCEPT
+{
+    __libc_free( ptr );
+}
+
+#if defined( __cpp_sized_deallocation )
+void operator delete( void* ptr, size_t ) _GLIBCXX_USE_NOEXCEPT
+{
+    __libc_free( ptr );
+}
+
+void operator delete[]( void* ptr, size_t ) _GLIBCXX_USE_NOEXCEPT
+{
+    __libc_free( ptr );
+}
+#endif
+
+#if defined( __cpp_aligned_new )
+void* operator new( size_t size, std::align_val_t alignment )
+{
+    CountAlloc();
+    void* ptr = __libc_memalign( (size_t)alignment, size ? size : 1 );
+
+    if( NULL == ptr )
+    {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void* operator new[]( size_t size, std::align_val_t alignment )
+{
+    return operator new( size, alignment );
+}
+
+void* operator new( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+    CountAlloc();
+    return __libc_memalign( (size_t)alignment, size ? size : 1 );
+}
+
+void* operator new[]( size_t size, std::align_val_t alignment, const std::nothrow_t& ) noexcept
+{
+    return operator new( size, alignment, std::nothrow );
+}
+
+void operator delete( void* ptr, std::align_val_t ) noexcept
+{
+    __libc_free( ptr );
+}
+
+void operator delete[]( void* ptr, std::align_val_t ) noexcept
+{
+    __libc_free( ptr );
+}
+
+void operator delete( void* ptr, size_t, std::align_val_t ) noexcept
+{
+    __libc_free( ptr );
+}
+
+void operator delete[]( void* ptr, size_t, std::align_val_t ) noexcept
+{
+    __libc_free( ptr );
+}
+#endif
+
+//-------------------------------------------------------------------------------------------------
+//                                test
+//-------------------------------------------------------------------------------------------------
+
+class TstCycleAlloc : public QObject
+{
+    Q_OBJECT
+
+public:
+    TstCycleAlloc();
+
+private:
+    CEvc_com*       m_pEvc_com;
+    double          m_Position;
+
+    // Client storage of the cyclic DMI calls (no std::vector)
+    SDmiComIcon     m_aIcons[ DMI_MAX_ICONS ];
+    SDmiComTextMsg  m_aTexts[ DMI_MAX_TEXT_MSG ];
+
+    bool runCycles( int32_t lNbCycles );
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void periodicPathDoesNotAllocate();
+};
+
+TstCycleAlloc::TstCycleAlloc() :
+    m_pEvc_com( NULL ),
+    m_Position( 0.0 )
+{
+}
+
+/// Client cycles: odometry in, one EVC step, then speed monitoring, TIU out and DMI dynamic packet
+/// @return false if a step failed
+bool TstCycleAlloc::runCycles( int32_t lNbCycles )
+{
+    volatile double dSpeed;
+    volatile int32_t lNb;
+    bool bStepOk = true;
+
+    for( int32_t i = 0; i < lNbCycles; i++ )
+    {
+        m_pEvc_com->ODO_Send_Odo_data( m_Position, TEST_SPEED_m_s, 0 );
+        m_Position = m_Position + TEST_SPEED_m_s * CYCLE_PERIOD_ms / 1000.0;
+
+        bStepOk = bStepOk && ( m_pEvc_com->SIM_Step( CYCLE_PERIOD_ms ) >= 0 );
+
+        dSpeed = m_pEvc_com->SIM_GetPermSpeed();
+        dSpeed = m_pEvc_com->SIM_GetTrainSpeed();
+        (void)m_pEvc_com->SIM_GetSpeedMonitoringStatus();
+
+        m_pEvc_com->ODO_RefreshTIUData();
+        (void)m_pEvc_com->ODO_getEvcTiu();
+
+        dSpeed = m_pEvc_com->DMI_getDynamicPacket().DMI_V_TRAIN;
+        lNb = m_pEvc_com->DMI_getIconList( m_aIcons, DMI_MAX_ICONS );
+        lNb = m_pEvc_com->DMI_getTextMessageList( m_aTexts, DMI_MAX_TEXT_MSG );
+    }
+
+    (void)dSpeed;
+    (void)lNb;
+    return bStepOk;
+}
+
+void TstCycleAlloc::initTestCase()
+{
+    m_pEvc_com = new CEvc_com();
+    m_pEvc_com->SIM_Modify_EVC_Configuration( false, CFG_USE_JRU );
+    m_pEvc_com->SIM_Modify_EVC_Configuration( true, CFG_STEP_MODE );
+    QCOMPARE( m_pEvc_com->SIM_Init( 0 ), 0 );
+    QCOMPARE( m_pEvc_com->SIM_Start_processes(), 0 );
+    QCOMPARE( m_pEvc_com->SIM_Run(), 0 );
+    QVERIFY( m_pEvc_com->SIM_Step( STARTUP_ms ) >= 0 );
+
+    // Power on and open cabin A (same as light_runner)
+    struct SRxTiuData tiu = m_pEvc_com->ODO_getTrainTiu();
+    tiu.bMainSwitchOn = true;
+    tiu.ActiveCabin   = CABIN_A;
+    m_pEvc_com->ODO_SetTiuDataDelta( &tiu, RX_TIU_MAIN_SWITCH | RX_TIU_CABIN );
+    QVERIFY( m_pEvc_com->SIM_Step( STARTUP_ms ) >= 0 );
+}
+
+void TstCycleAlloc::cleanupTestCase()
+{
+    if( NULL != m_pEvc_com )
+    {
+        m_pEvc_com->SIM_Stop();
+        delete m_pEvc_com;
+        m_pEvc_com = NULL;
+    }
+}
+
+void TstCycleAlloc::periodicPathDoesNotAllocate()
+{
+    QVERIFY( runCycles( WARMUP_CYCLE_NB ) );
+
+    // No QTest call while counting: only the EVC and the client cycle are measured
+    g_ulAllocCnt  = 0;
+    g_bCountAlloc = true;
+    bool bStepOk  = runCycles( TEST_CYCLE_NB );
+    g_bCountAlloc = false;
+
+    QVERIFY( bStepOk );
+
+    uint32_t ulAllocCnt = g_ulAllocCnt;
+    QCOMPARE( ulAllocCnt, (uint32_t)0 );
+
+    // Also counted inside the EVC when it is built with EVC_COUNT_ALLOCATIONS (0 otherwise)
+    SResourceUsage Usage;
+    m_pEvc_com->SIM_GetResourceUsage( &Usage );
+    QCOMPARE( Usage.ullCycleAllocCnt, (uint64_t)0 );
+}
+
+QTEST_APPLESS_MAIN( TstCycleAlloc )
+
+#include "tst_cyclealloc.moc"
@@ -0,0 +1,46 @@
+#                                                                  #
+#             +++ ERTMS/ETCS "light" TESTRUNNER +++                #
+#                                                                  #
+# Copyright © 2014 - European Rail Software Applications (ERSA)    #
+#                    5 rue Maurice Blin                            #
+#                    67500 HAGUENAU                                #
+#                    FRANCE                                        #
+#                    http://www.ersa-france.com                    #
+#                                                                  #
+# Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)           #
+#                                                                  #
+# Licensed under the EUPL Version 1.1.                             #
+#                                                                  #
+# You may not use this work except in compliance with the License. #
+# You may obtain a copy of the License at:                         #
+# http://ec.europa.eu/idabc/eupl.html                              #
+#                                                                  #
+# Unless required by applicable law or agreed to in writing,       #
+# software distributed under the License is distributed on an      #
+# "AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,     #
+# either express or implied. See the License for the specific      #
+# language governing permissions and limitations under the License.#
+#                                                                  #
+#       qmake configuration file of the periodic allocation test   #
+#                                                                  #
+####################################################################
+
+include( ../light_runner.pri )
+
+TARGET              =   tst_cyclealloc$${SUFFIX_STR}
+
+# Project configuration (run with "make check", here or in light_runner)
+TEMPLATE            =   app
+
+CONFIG              *=  console testcase
+CONFIG              -=  app_bundle
+QT                  *=  core
+QT                  -=  gui
+
+greaterThan(QT_MAJOR_VERSION, 4) {
+    QT              *=  testlib
+} else {
+    CONFIG          *=  qtestlib
+}
+
+SOURCES             =   tst_cyclealloc.cpp
@@ -0,0 +1,48 @@
+/*****************************************************************
+Copyright © 2014 - European Rail Software Applications (ERSA)
+                   5 rue Maurice Blin
+                   67500 HAGUENAU
+                   FRANCE
+                   http://www.ersa-france.com
+
+Author(s): Alexis JULIN (ERSA), Didier WECKMANN (ERSA)
+
+Licensed under the EUPL Version 1.1.
+
+You may not use this work except in compliance with the License.
+You may obtain a copy of the License at:
+http://ec.europa.eu/idabc/eupl.html
+
+Unless required by applicable law or agreed to in writing,
+software distributed under the License is distributed on an
+"AS IS" basis, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND,
+either express or implied. See the License for the specific
+language governing permissions and limitations under the License.
+*****************************************************************/
+
+//*************************************************************************************************
+/// @file   shared_layout.cpp
+/// @brief  Host tool run by the build: writes the layout report of the shared data blocks
+///         (offset and size of each block, see SHARED_LAYOUT_TABLE) on the standard output.
+//*************************************************************************************************
+
+#include <stdio.h>
+
+#include "etcs_types.h"
+
+/// Print one block of the table, flag it when it does not start a cache line
+#define PRINT_SHARED_LAYOUT_BLOCK( _type, _block, _name ) \
+    printf( "%-16s %-12s %-24s %8d %8d%s\n", #_type, #_block, _name, \
+            (int)offsetof( _type, _block ), (int)sizeof( ( (_type*)0 )->_block ), \
+            IS_CACHE_ALIGNED( _type, _block ) ? "" : "  NOT ALIGNED" );
+
+int main()
+{
+    printf( "Shared data layout (cache line %d bytes)\n", CACHE_LINE_SIZE );
+    printf( "SETCS_IO size %d, SSupervisionData size %d\n\n", (int)sizeof( SETCS_IO ), (int)sizeof( SSupervisionData ) );
+    printf( "%-16s %-12s %-24s %8s %8s\n", "structure", "block", "writer", "offset", "size" );
+
+    SHARED_LAYOUT_TABLE( PRINT_SHARED_LAYOUT_BLOCK )
+
+    return 0;
+}